@@ -73,3 +73,7 @@ int os_perso_derive_node_bip32(uint32_t curve, const uint32_t *path, uint32_t pa
     if (chainCode) memset(chainCode, 0x22, 32);
     return 0;
 }
+
+void *pic(void *linked_address) {
+    return linked_address;
+}
@@ -46,19 +46,35 @@ The Ontology address is a base58 encoding of the pre-address.
 
 #include "address.h"
 #include "types.h"
-#include "base58.h"
+#include "address_base58.h"
 #include "lcx_common.h"
 #include "lcx_sha256.h"
 #include "lcx_ripemd160.h"
-#include "crypto_helpers.h"
-#include "../globals.h"
-#include "address.h"
 
 #define ADDRESS_VERSION 23  // 0x17
 #define ADDRESS_SCRIPT_LEN       35
 #define SCRIPT_HASH_CHECKSUM_LEN 4
 #define ADDRESS_PRE_LEN          (1 + ADDRESS_SCRIPT_HASH_LEN + SCRIPT_HASH_CHECKSUM_LEN)
-#define BASE58_ADDRESS_LEN       34
+
+_Static_assert(ADDRESS_PRE_LEN == ADDRESS_BASE58_IN_LEN, "address length");
+
+bool compress_public_key(const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN],
+                         uint8_t out[static COMPRESSED_KEY_LEN]) {
+    LEDGER_ASSERT(uncompressed_key != NULL, "NULL uncompressed_key");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+
+    if (uncompressed_key[0] != 0x04) {
+        return false;
+    }
+    const uint8_t *x = &uncompressed_key[1];
+    const uint8_t *y = &uncompressed_key[33];
+
+    out[0] = (y[31] & 1) ? 0x03 : 0x02;
+    memcpy(&out[1], x, 32);
+
+    return true;
+}
+
 static bool covert_pk_to_address_script(const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN],
                                         uint8_t *out,
                                         size_t out_len) {
@@ -69,15 +85,10 @@ static bool covert_pk_to_address_script(const uint8_t uncompressed_key[static UN
         return false;
     }
 
-    if (uncompressed_key[0] != 0x04) {
+    uint8_t compressed_key[COMPRESSED_KEY_LEN];
+    if (!compress_public_key(uncompressed_key, compressed_key)) {
         return false;
     }
-    const uint8_t *x = &uncompressed_key[1];
-    const uint8_t *y = &uncompressed_key[33];
-    uint8_t compressed_key[COMPRESSED_KEY_LEN];
-
-    compressed_key[0] = (y[31] & 1) ? 0x03 : 0x02;
-    memcpy(&compressed_key[1], x, 32);
 
     out[0] = OPCODE_PUSHBYTES21;
     memcpy(&out[1], compressed_key, sizeof(compressed_key));
@@ -110,7 +121,7 @@ bool convert_script_hash_to_base58_address(char *out, size_t out_len, const uint
     LEDGER_ASSERT(out != NULL, "NULL out");
     LEDGER_ASSERT(script_hash != NULL, "NULL script_hash");
 
-    if (out_len < BASE58_ADDRESS_LEN) {
+    if (out_len < BASE58_ADDRESS_LEN + 1) {
         return false;
     }
 
@@ -126,7 +137,7 @@ bool convert_script_hash_to_base58_address(char *out, size_t out_len, const uint
 
     memcpy(&address[1 + ADDRESS_SCRIPT_HASH_LEN], data_hash_2, SCRIPT_HASH_CHECKSUM_LEN);
 
-    result = result && base58_encode(address, sizeof(address), out, out_len);
+    result = result && address_base58_encode(address, out, out_len) == BASE58_ADDRESS_LEN;
 
     explicit_bzero(data_hash_1, sizeof(data_hash_1));
     explicit_bzero(data_hash_2, sizeof(data_hash_2));
@@ -135,46 +146,39 @@ bool convert_script_hash_to_base58_address(char *out, size_t out_len, const uint
     return result;
 }
 
-bool convert_uncompressed_pubkey_to_address(
-    char *out,
-    size_t out_len,
-    const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN]) {
+bool convert_uncompressed_pubkey_to_script_hash(
+    const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN],
+    uint8_t out[static ADDRESS_SCRIPT_HASH_LEN]) {
     LEDGER_ASSERT(uncompressed_key != NULL, "NULL uncompressed_key");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    if (out_len < BASE58_ADDRESS_LEN) {
-        return false;
-    }
-
     uint8_t script[ADDRESS_SCRIPT_LEN] = {0};
-    uint8_t ripemd160_hash[ADDRESS_SCRIPT_HASH_LEN] = {0};
 
     bool result = covert_pk_to_address_script(uncompressed_key, script, sizeof(script)) &&
-                  hash_script(script, sizeof(script), ripemd160_hash) &&
-                  convert_script_hash_to_base58_address(out, out_len, ripemd160_hash);
+                  hash_script(script, sizeof(script), out);
 
     explicit_bzero(script, sizeof(script));
-    explicit_bzero(ripemd160_hash, sizeof(ripemd160_hash));
 
     return result;
 }
 
-bool derive_address_from_bip32_path(char *out, size_t out_len) {
+bool convert_uncompressed_pubkey_to_address(
+    char *out,
+    size_t out_len,
+    const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN]) {
+    LEDGER_ASSERT(uncompressed_key != NULL, "NULL uncompressed_key");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    uint8_t uncompressed_key[UNCOMPRESSED_KEY_LEN];
-    uint8_t chain_code[CHAIN_CODE_LEN];
+    if (out_len < BASE58_ADDRESS_LEN + 1) {
+        return false;
+    }
 
-    bool result = (bip32_derive_get_pubkey_256(CX_CURVE_256R1,
-                                               G_context.bip32_path,
-                                               G_context.bip32_path_len,
-                                               uncompressed_key,
-                                               chain_code,
-                                               CX_SHA256) == CX_OK) &&
-                  convert_uncompressed_pubkey_to_address(out, out_len, uncompressed_key);
+    uint8_t ripemd160_hash[ADDRESS_SCRIPT_HASH_LEN] = {0};
 
-    explicit_bzero(uncompressed_key, sizeof(uncompressed_key));
-    explicit_bzero(chain_code, sizeof(chain_code));
+    bool result = convert_uncompressed_pubkey_to_script_hash(uncompressed_key, ripemd160_hash) &&
+                  convert_script_hash_to_base58_address(out, out_len, ripemd160_hash);
+
+    explicit_bzero(ripemd160_hash, sizeof(ripemd160_hash));
 
     return result;
-}
\ No newline at end of file
+}
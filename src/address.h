@@ -7,9 +7,33 @@
 #define UNCOMPRESSED_KEY_LEN     65
 #define COMPRESSED_KEY_LEN       33
 #define ADDRESS_SCRIPT_HASH_LEN  20
+#define BASE58_ADDRESS_LEN       34  // length of a base58 address, without the null terminator
 
 #define CHAIN_CODE_LEN 32
 
+/**
+ * @brief Compresses a secp256r1 public key.
+ *
+ * @param[in] uncompressed_key The uncompressed public key, 0x04 || x || y.
+ * @param[out] out The compressed public key, 0x02 or 0x03 || x.
+ *
+ * @return true if the key is uncompressed, false otherwise.
+ */
+bool compress_public_key(const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN],
+                         uint8_t out[static COMPRESSED_KEY_LEN]);
+
+/**
+ * @brief Computes the script hash of the verification script of a public key.
+ *
+ * @param[in] uncompressed_key The uncompressed public key.
+ * @param[out] out The RIPEMD-160 of the SHA-256 of the script, 0x21 || compressed key || CHECKSIG.
+ *
+ * @return true if the conversion is successful, false otherwise.
+ */
+bool convert_uncompressed_pubkey_to_script_hash(
+    const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN],
+    uint8_t out[static ADDRESS_SCRIPT_HASH_LEN]);
+
 /**
  * @brief Converts a address script to a base58 address.
  *
@@ -38,17 +62,3 @@ bool convert_uncompressed_pubkey_to_address(
     char* out,
     size_t out_len,
     const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN]);
-
-/**
- * @brief Derives an Ontology address from a given BIP32 path.
- *
- * This function generates an Ontology address based on the provided
- * BIP32 path and writes it to the output buffer.
- *
- * @param[out] out      A pointer to the buffer where the derived address will be stored.
- * @param[in]  out_len  The size of the output buffer in bytes.
- *
- * @return true if the address was successfully derived and written to the buffer,
- *         false if an error occurred (e.g., insufficient buffer size).
- */
-bool derive_address_from_bip32_path(char* out, size_t out_len);
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <string.h>  // memcpy, memset, explicit_bzero
+
+#include "address_base58.h"
+
+#define LIMBS_NUM    7           // 28 bytes, the 25 bytes of input after 3 zero bytes
+#define DIGITS_STEP  5           // digits produced by a division
+#define BASE58_POW5  656356768U  // 58^5, the largest power of 58 below 2^32
+
+static const char BASE58_ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+int address_base58_encode(const uint8_t in[static ADDRESS_BASE58_IN_LEN],
+                          char *out,
+                          size_t out_len) {
+    if (in == NULL || out == NULL) {
+        return -1;
+    }
+
+    // Big-endian limbs, the most significant first
+    uint32_t limbs[LIMBS_NUM];
+    uint8_t bytes[LIMBS_NUM * sizeof(uint32_t)] = {0};
+    memcpy(bytes + sizeof(bytes) - ADDRESS_BASE58_IN_LEN, in, ADDRESS_BASE58_IN_LEN);
+    for (size_t i = 0; i < LIMBS_NUM; i++) {
+        limbs[i] = (uint32_t) bytes[4 * i] << 24 | (uint32_t) bytes[4 * i + 1] << 16 |
+                   (uint32_t) bytes[4 * i + 2] << 8 | bytes[4 * i + 3];
+    }
+
+    // Digits of the value, least significant last
+    uint8_t digits[ADDRESS_BASE58_MAX_LEN];
+    size_t pos = sizeof(digits);
+    size_t first = 0;  // first non-zero limb
+    while (pos > 0) {
+        uint32_t rem = 0;
+        for (size_t i = first; i < LIMBS_NUM; i++) {
+            uint64_t cur = (uint64_t) rem << 32 | limbs[i];
+            limbs[i] = (uint32_t) (cur / BASE58_POW5);
+            rem = (uint32_t) (cur % BASE58_POW5);
+        }
+        while (first < LIMBS_NUM && limbs[first] == 0) {
+            first++;
+        }
+        for (size_t k = 0; k < DIGITS_STEP; k++) {
+            digits[--pos] = (uint8_t) (rem % 58);
+            rem /= 58;
+        }
+    }
+
+    // Leading zero bytes are encoded as '1', the leading zero digits of the value are dropped
+    size_t zeros = 0;
+    while (zeros < ADDRESS_BASE58_IN_LEN && in[zeros] == 0) {
+        zeros++;
+    }
+    while (pos < sizeof(digits) && digits[pos] == 0) {
+        pos++;
+    }
+    size_t len = zeros + sizeof(digits) - pos;
+    if (out_len < len + 1) {
+        return -1;
+    }
+
+    memset(out, BASE58_ALPHABET[0], zeros);
+    for (size_t i = zeros; i < len; i++) {
+        out[i] = BASE58_ALPHABET[digits[pos++]];
+    }
+    out[len] = '\0';
+
+    explicit_bzero(limbs, sizeof(limbs));
+    explicit_bzero(bytes, sizeof(bytes));
+    explicit_bzero(digits, sizeof(digits));
+    return (int) len;
+}
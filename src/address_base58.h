@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+
+// An address is encoded from its version byte, script hash and checksum
+#define ADDRESS_BASE58_IN_LEN 25
+// Maximum length of the encoding of 25 bytes, 58^35 > 2^200
+#define ADDRESS_BASE58_MAX_LEN 35
+
+/**
+ * @brief Encodes the 25 bytes of an address in base58.
+ *
+ * Same output as the generic base58_encode of the SDK, for this input length only. The value is
+ * held in 32-bit limbs and divided by 58^5 at each step, giving five digits per division.
+ *
+ * @param[in] in The 25 bytes to encode.
+ * @param[out] out Buffer to store the null-terminated encoding.
+ * @param[in] out_len Size of the buffer, the encoding of an Ontology address needs 35 bytes.
+ *
+ * @return the length of the encoding, without the null terminator, or -1 if the buffer is too
+ *         small.
+ */
+int address_base58_encode(const uint8_t in[static ADDRESS_BASE58_IN_LEN],
+                          char *out,
+                          size_t out_len);
@@ -30,7 +30,11 @@
 #include "get_version.h"
 #include "get_app_name.h"
 #include "get_public_key.h"
+#include "get_public_keys.h"
 #include "sign_tx.h"
+#include "sign_tx_batch.h"
+#include "sign_tx_result.h"
+#include "session.h"
 #include "sign_msg.h"
 
 int apdu_dispatcher(const command_t *cmd) {
@@ -40,6 +44,13 @@ int apdu_dispatcher(const command_t *cmd) {
         return io_send_sw(SW_CLA_NOT_SUPPORTED);
     }
 
+    // These commands reset or use G_context, which a queued review may be displaying
+    if (G_tx_queue.pending_num != 0 &&
+        (cmd->ins == GET_PUBLIC_KEY || cmd->ins == GET_PUBLIC_KEYS || cmd->ins == SIGN_MESSAGE ||
+         cmd->ins == SIGN_TX_BATCH || cmd->ins == OPEN_SESSION)) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
     buffer_t buf = {0};
 
     switch (cmd->ins) {
@@ -56,7 +67,7 @@ int apdu_dispatcher(const command_t *cmd) {
 
             return handler_get_app_name();
         case GET_PUBLIC_KEY:
-            if (cmd->p1 > 1 || cmd->p2 > 0) {
+            if (cmd->p1 > 1 || cmd->p2 > PUBKEY_FORMAT_ADDRESS) {
                 return io_send_sw(SW_WRONG_P1P2);
             }
 
@@ -68,12 +79,33 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.size = cmd->lc;
             buf.offset = 0;
 
-            return handler_get_public_key(&buf, (bool) cmd->p1);
+            return handler_get_public_key(&buf, (bool) cmd->p1, (pubkey_format_e) cmd->p2);
+        case GET_PUBLIC_KEYS:
+            if (cmd->p1 > PUBKEYS_FORMAT_SCRIPT_HASH || cmd->p2 > 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_get_public_keys(&buf, cmd->p1);
         case SIGN_TX:
-        case SIGN_MESSAGE:
-            if ((cmd->p1 == P1_START && cmd->p2 != P2_MORE) ||  //
-                cmd->p1 > P1_MAX ||                             //
-                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+        case SIGN_MESSAGE: {
+            // In a session the first APDU holds data and may be the last one. Outside of a
+            // session, a first APDU which is also the last one holds the path and the data.
+            // The transaction data can be template encoded.
+            bool in_session = cmd->p1 == P1_START && (cmd->p2 & P2_SESSION);
+            uint8_t p2 = in_session ? cmd->p2 & ~P2_SESSION : cmd->p2;
+            bool encoded = cmd->ins == SIGN_TX && (p2 & P2_TEMPLATE);
+            p2 = encoded ? p2 & ~P2_TEMPLATE : p2;
+
+            if (cmd->p1 > P1_MAX ||
+                (p2 != P2_LAST && p2 != P2_MORE && (p2 != P2_QUEUE || cmd->ins != SIGN_TX))) {
                 return io_send_sw(SW_WRONG_P1P2);
             }
 
@@ -86,8 +118,59 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.offset = 0;
 
             return cmd->ins == SIGN_TX
-                       ? handler_sign_tx(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE))
-                       : handler_sign_message(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
+                       ? handler_sign_tx(&buf,
+                                         cmd->p1,
+                                         (bool) (p2 & P2_MORE),
+                                         p2 == P2_QUEUE,
+                                         in_session,
+                                         encoded)
+                       : handler_sign_message(&buf, cmd->p1, (bool) (p2 & P2_MORE), in_session);
+        }
+        case SIGN_TX_BATCH: {
+            bool encoded = cmd->p1 == P1_BATCH_TX && (cmd->p2 & P2_TEMPLATE);
+            uint8_t p2 = encoded ? cmd->p2 & ~P2_TEMPLATE : cmd->p2;
+
+            if (cmd->p1 > P1_BATCH_SIGNATURES || (p2 != P2_LAST && p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            // Only the end of the batch comes without data
+            if (!cmd->data && cmd->p1 != P1_BATCH_END) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_batch(&buf, cmd->p1, (bool) (p2 & P2_MORE), encoded);
+        }
+        case OPEN_SESSION:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_open_session(&buf);
+        case CLOSE_SESSION:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            return handler_close_session();
+        case SIGN_TX_RESULT:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            return handler_sign_tx_result();
         default:
             return io_send_sw(SW_INS_NOT_SUPPORTED);
     }
@@ -11,6 +11,18 @@
  * Parameter 2 for more APDU to receive.
  */
 #define P2_MORE 0x80
+/**
+ * Parameter 2 for last APDU of a queued SIGN_TX, answered before the review.
+ */
+#define P2_QUEUE 0x01
+/**
+ * Parameter 2 flag for a first APDU using the BIP32 path of the session, with data.
+ */
+#define P2_SESSION 0x40
+/**
+ * Parameter 2 flag for transaction data sent template encoded, see transaction/template.h.
+ */
+#define P2_TEMPLATE 0x20
 /**
  * Parameter 1 for first APDU number.
  */
@@ -29,6 +29,8 @@
 #include "dispatcher.h"
 
 global_ctx_t G_context;
+tx_queue_ctx_t G_tx_queue;
+session_ctx_t G_session;
 
 const internal_storage_t N_storage_real;
 
@@ -46,6 +48,8 @@ void app_main() {
 
     // Reset context
     explicit_bzero(&G_context, sizeof(G_context));
+    explicit_bzero(&G_tx_queue, sizeof(G_tx_queue));
+    explicit_bzero(&G_session, sizeof(G_session));
 
     // Initialize the NVM data if required
     if (N_storage.initialized != 0x01) {
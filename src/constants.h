@@ -26,7 +26,7 @@
 #if defined(TARGET_STAX) || defined(TARGET_FLEX)
 #define MAX_TRANSACTION_LEN (1024 * 6 + 700)
 #else
-#define MAX_TRANSACTION_LEN (1024 * 4)
+#define MAX_TRANSACTION_LEN (1024 * 4 + 512)
 #endif
 /**
  * Maximum personal message length (bytes).
@@ -13,6 +13,16 @@
  */
 extern global_ctx_t G_context;
 
+/**
+ * Queued transactions, kept apart from G_context which every command resets.
+ */
+extern tx_queue_ctx_t G_tx_queue;
+
+/**
+ * Signing session, kept until it is closed or the application exits.
+ */
+extern session_ctx_t G_session;
+
 /**
  * Global structure for NVM data storage.
  */
@@ -32,12 +32,14 @@
 #include "sw.h"
 #include "display.h"
 #include "send_response.h"
+#include "../pubkey_cache.h"
 #include "../transaction/utils.h"
 
-int handler_get_public_key(buffer_t *cdata, bool display) {
+int handler_get_public_key(buffer_t *cdata, bool display, pubkey_format_e format) {
     explicit_bzero(&G_context, sizeof(G_context));
     G_context.req_type = CONFIRM_ADDRESS;
     G_context.state = STATE_NONE;
+    G_context.pk_info.format = format;
 
     if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
         !buffer_read_bip32_path(cdata, G_context.bip32_path, (size_t) G_context.bip32_path_len)) {
@@ -48,12 +50,10 @@ int handler_get_public_key(buffer_t *cdata, bool display) {
         return io_send_sw(SW_INVALID_PATH);
     }
 
-    cx_err_t error = bip32_derive_get_pubkey_256(CX_CURVE_256R1,
-                                                 G_context.bip32_path,
-                                                 G_context.bip32_path_len,
-                                                 G_context.pk_info.raw_public_key,
-                                                 G_context.pk_info.chain_code,
-                                                 CX_SHA256);
+    cx_err_t error = pubkey_cache_get(G_context.bip32_path,
+                                      G_context.bip32_path_len,
+                                      G_context.pk_info.raw_public_key,
+                                      G_context.pk_info.chain_code);
 
     if (error != CX_OK) {
         return io_send_sw(error);
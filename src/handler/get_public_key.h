@@ -19,8 +19,10 @@
  *   Command data with BIP32 path.
  * @param[in]     display
  *   Whether to display address on screen or not.
+ * @param[in]     format
+ *   Format of the response.
  *
  * @return zero or positive integer if success, negative integer otherwise.
  *
  */
-int handler_get_public_key(buffer_t *cdata, bool display);
+int handler_get_public_key(buffer_t *cdata, bool display, pubkey_format_e format);
@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // explicit_bzero
+
+#include "os.h"
+#include "cx.h"
+#include "io.h"
+#include "buffer.h"
+
+#include "get_public_keys.h"
+#include "globals.h"
+#include "types.h"
+#include "sw.h"
+#include "../address.h"
+#include "../pubkey_cache.h"
+#include "../transaction/utils.h"
+
+#define HARDENED_INDEX   0x80000000U
+#define MAX_RESPONSE_LEN 255  // 7 compressed keys or 12 script hashes
+
+int handler_get_public_keys(buffer_t *cdata, uint8_t format) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    G_context.req_type = CONFIRM_ADDRESS;
+    G_context.state = STATE_NONE;
+
+    uint8_t base_len = 0;
+    uint32_t first_index = 0;
+    uint8_t count = 0;
+    if (!buffer_read_u8(cdata, &base_len) || base_len >= MAX_BIP32_PATH ||
+        !buffer_read_bip32_path(cdata, G_context.bip32_path, (size_t) base_len) ||
+        !buffer_read_u32(cdata, &first_index, BE) || !buffer_read_u8(cdata, &count) ||
+        count == 0) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+
+    // The indices are appended to the base path and must all be non-hardened
+    if (!is_valid_bip44_prefix(G_context.bip32_path, base_len) || first_index >= HARDENED_INDEX ||
+        count > HARDENED_INDEX - first_index) {
+        return io_send_sw(SW_INVALID_PATH);
+    }
+    G_context.bip32_path_len = base_len + 1;
+
+    const size_t key_len =
+        format == PUBKEYS_FORMAT_COMPRESSED ? COMPRESSED_KEY_LEN : ADDRESS_SCRIPT_HASH_LEN;
+    uint8_t resp[MAX_RESPONSE_LEN] = {0};
+    size_t offset = 1;
+
+    uint8_t num = 0;
+    for (; num < count && offset + key_len <= sizeof(resp); num++) {
+        G_context.bip32_path[base_len] = first_index + num;
+
+        cx_err_t error = pubkey_cache_get(G_context.bip32_path,
+                                          G_context.bip32_path_len,
+                                          G_context.pk_info.raw_public_key,
+                                          NULL);
+        if (error != CX_OK) {
+            return io_send_sw(error);
+        }
+
+        bool result =
+            format == PUBKEYS_FORMAT_COMPRESSED
+                ? compress_public_key(G_context.pk_info.raw_public_key, resp + offset)
+                : convert_uncompressed_pubkey_to_script_hash(G_context.pk_info.raw_public_key,
+                                                             resp + offset);
+        if (!result) {
+            return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        }
+        offset += key_len;
+    }
+    resp[0] = num;
+
+    return io_send_response_pointer(resp, offset, SW_OK);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>  // uint*_t
+
+#include "buffer.h"
+
+/**
+ * Formats of the keys returned by GET_PUBLIC_KEYS, in P1.
+ */
+#define PUBKEYS_FORMAT_COMPRESSED  0x00  /// compressed public keys (33 bytes)
+#define PUBKEYS_FORMAT_SCRIPT_HASH 0x01  /// script hashes of the addresses (20 bytes)
+
+/**
+ * Handler for GET_PUBLIC_KEYS command. Derive the keys of consecutive non-hardened indices
+ * below a base BIP32 path and send as many as fit in one APDU response, without display.
+ *
+ * cdata = path_len (1) || base path (4 * path_len) || first index (4) || count (1)
+ *
+ * response = number of keys (1) ||
+ *            keys (33 or 20 bytes each, depending on the format)
+ *
+ * @param[in,out] cdata
+ *   Command data with the base BIP32 path and the index range.
+ * @param[in]     format
+ *   PUBKEYS_FORMAT_COMPRESSED or PUBKEYS_FORMAT_SCRIPT_HASH.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_public_keys(buffer_t *cdata, uint8_t format);
@@ -0,0 +1,100 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memcpy, explicit_bzero
+
+#include "cx.h"
+#include "io.h"
+#include "buffer.h"
+
+#include "session.h"
+#include "globals.h"
+#include "sw.h"
+#include "types.h"
+#include "../address.h"
+#include "../pubkey_cache.h"
+#include "../transaction/utils.h"
+
+uint16_t session_read_signer(buffer_t *cdata,
+                             bool in_session,
+                             uint32_t *path,
+                             uint8_t *path_len,
+                             char *signer_address,
+                             size_t signer_address_len,
+                             uint8_t *signer_script_hash) {
+    if (in_session) {
+        if (!G_session.open || signer_address_len < sizeof(G_session.signer_address)) {
+            return SW_BAD_STATE;
+        }
+        memcpy(path, G_session.bip32_path, sizeof(G_session.bip32_path));
+        *path_len = G_session.bip32_path_len;
+        memcpy(signer_address, G_session.signer_address, sizeof(G_session.signer_address));
+        if (signer_script_hash != NULL) {
+            memcpy(signer_script_hash,
+                   G_session.signer_script_hash,
+                   sizeof(G_session.signer_script_hash));
+        }
+        return SW_OK;
+    }
+
+    if (!buffer_read_u8(cdata, path_len) ||
+        !buffer_read_bip32_path(cdata, path, (size_t) *path_len)) {
+        return SW_WRONG_DATA_LENGTH;
+    }
+    if (!is_valid_bip44_prefix(path, *path_len)) {
+        return SW_INVALID_PATH;
+    }
+
+    uint8_t raw_public_key[UNCOMPRESSED_KEY_LEN];
+    uint8_t script_hash[ADDRESS_SCRIPT_HASH_LEN];
+    bool result =
+        pubkey_cache_get(path, *path_len, raw_public_key, NULL) == CX_OK &&
+        convert_uncompressed_pubkey_to_script_hash(raw_public_key, script_hash) &&
+        convert_script_hash_to_base58_address(signer_address, signer_address_len, script_hash);
+    if (result && signer_script_hash != NULL) {
+        memcpy(signer_script_hash, script_hash, sizeof(script_hash));
+    }
+
+    explicit_bzero(raw_public_key, sizeof(raw_public_key));
+    return result ? SW_OK : SW_DISPLAY_ADDRESS_FAIL;
+}
+
+int handler_open_session(buffer_t *cdata) {
+    explicit_bzero(&G_session, sizeof(G_session));
+
+    uint16_t sw = session_read_signer(cdata,
+                                      false,
+                                      G_session.bip32_path,
+                                      &G_session.bip32_path_len,
+                                      G_session.signer_address,
+                                      sizeof(G_session.signer_address),
+                                      G_session.signer_script_hash);
+    if (sw != SW_OK) {
+        explicit_bzero(&G_session, sizeof(G_session));
+        return io_send_sw(sw);
+    }
+    G_session.open = true;
+    return io_send_sw(SW_OK);
+}
+
+int handler_close_session() {
+    explicit_bzero(&G_session, sizeof(G_session));
+    return io_send_sw(SW_OK);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+
+#include "buffer.h"
+
+/**
+ * Handler for OPEN_SESSION command. Validate the BIP32 path and derive the address of its
+ * signer once, for the SIGN_TX and SIGN_MESSAGE commands which start without a path.
+ *
+ * cdata = path_len (1) || path (4 * path_len)
+ *
+ * @see G_session.
+ *
+ * @param[in,out] cdata
+ *   Command data with the BIP32 path.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_open_session(buffer_t *cdata);
+
+/**
+ * Handler for CLOSE_SESSION command. Forget the path of the session.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_close_session(void);
+
+/**
+ * Read the BIP32 path of a signing request and derive the address of its signer, or take both
+ * from the open session.
+ * Called with the first APDU of a request, the signer is derived while the host waits for its
+ * answer rather than after the last chunk. The path is read from the start of the APDU, whose
+ * remaining bytes, if any, are the first data of the request.
+ *
+ * @param[in,out] cdata
+ *   Command data with the BIP32 path, not read in a session.
+ * @param[in]     in_session
+ *   Whether the request uses the path of the session.
+ * @param[out]    path
+ *   BIP32 path, MAX_BIP32_PATH elements.
+ * @param[out]    path_len
+ *   Number of elements of the path.
+ * @param[out]    signer_address
+ *   Base58 address of the path, null-terminated.
+ * @param[in]     signer_address_len
+ *   Size of the address buffer.
+ * @param[out]    signer_script_hash
+ *   Script hash of the path, ADDRESS_SCRIPT_HASH_LEN bytes. NULL if not needed.
+ *
+ * @return SW_OK if success, the status word of the failure otherwise.
+ *
+ */
+uint16_t session_read_signer(buffer_t *cdata,
+                             bool in_session,
+                             uint32_t *path,
+                             uint8_t *path_len,
+                             char *signer_address,
+                             size_t signer_address_len,
+                             uint8_t *signer_script_hash);
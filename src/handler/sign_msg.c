@@ -26,68 +26,70 @@
 #include "../globals.h"
 #include "../ui/display.h"
 #include "sign_msg.h"
+#include "session.h"
 #include "../message/types.h"
 #include "../transaction/utils.h"
 #include "../address.h"
 
 #define MSG_LEN_MAX_CHARS 8
-int handler_sign_message(buffer_t *cdata, uint8_t chunk, bool more) {
-    if (chunk == 0) {  // first APDU, parse BIP32 path
+int handler_sign_message(buffer_t *cdata, uint8_t chunk, bool more, bool in_session) {
+    if (chunk == 0) {  // first APDU, parse BIP32 path or take the one of the session
         explicit_bzero(&G_context, sizeof(G_context));
         G_context.req_type = CONFIRM_MESSAGE;
         G_context.state = STATE_NONE;
 
-        if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
-            !buffer_read_bip32_path(cdata,
-                                    G_context.bip32_path,
-                                    (size_t) G_context.bip32_path_len)) {
-            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        uint16_t sw = session_read_signer(cdata,
+                                          in_session,
+                                          G_context.bip32_path,
+                                          &G_context.bip32_path_len,
+                                          G_context.signer_address,
+                                          sizeof(G_context.signer_address),
+                                          NULL);
+        // In a session, or when it is also the last one, the first APDU holds message data
+        if (sw != SW_OK || (!in_session && more)) {
+            return io_send_sw(sw);
         }
-        if (!is_valid_bip44_prefix(G_context.bip32_path, G_context.bip32_path_len)) {
-            return io_send_sw(SW_INVALID_PATH);
-        }
-        return io_send_sw(SW_OK);
-    } else {
-        if (G_context.req_type != CONFIRM_MESSAGE) {
-            return io_send_sw(SW_BAD_STATE);
-        }
-        if (G_context.msg_info.raw_msg_len + cdata->size > sizeof(G_context.msg_info.raw_msg)) {
-            return io_send_sw(SW_WRONG_DATA_LENGTH);
-        }
-        if (!buffer_move(cdata,
-                         G_context.msg_info.raw_msg + G_context.msg_info.raw_msg_len,
-                         cdata->size)) {
-            return io_send_sw(SW_PERSONAL_MSG_PARSING_FAIL);
-        }
-        G_context.msg_info.raw_msg_len += cdata->size;
-        if (more) {
-            // more APDUs with message siging request part are expected.
-            // Send a SW_OK to signal that we have received the chunk
-            return io_send_sw(SW_OK);
+    }
 
-        } else {
-            // last APDU for this message siging request, let's display and request a sign
-            // confirmation
-            G_context.state = STATE_PARSED;
+    if (G_context.req_type != CONFIRM_MESSAGE) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    size_t chunk_len = cdata->size - cdata->offset;
+    if (G_context.msg_info.raw_msg_len + chunk_len > sizeof(G_context.msg_info.raw_msg)) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+    if (!buffer_move(cdata,
+                     G_context.msg_info.raw_msg + G_context.msg_info.raw_msg_len,
+                     chunk_len)) {
+        return io_send_sw(SW_PERSONAL_MSG_PARSING_FAIL);
+    }
+    G_context.msg_info.raw_msg_len += chunk_len;
+    if (more) {
+        // more APDUs with message siging request part are expected.
+        // Send a SW_OK to signal that we have received the chunk
+        return io_send_sw(SW_OK);
 
-            cx_sha256_t cx_sha256;
-            cx_sha256_init(&cx_sha256);
+    } else {
+        // last APDU for this message siging request, let's display and request a sign
+        // confirmation
+        G_context.state = STATE_PARSED;
 
-            char len[MSG_LEN_MAX_CHARS];
-            snprintf(len, sizeof(len), "%u", G_context.msg_info.raw_msg_len);
+        cx_sha256_t cx_sha256;
+        cx_sha256_init(&cx_sha256);
 
-            if (cx_hash_update((cx_hash_t *) &cx_sha256, SIGN_MAGIC, sizeof(SIGN_MAGIC)) != CX_OK ||
-                cx_hash_update((cx_hash_t *) &cx_sha256, (uint8_t *) len, strlen(len)) != CX_OK ||
-                cx_hash_update((cx_hash_t *) &cx_sha256,
-                               G_context.msg_info.raw_msg,
-                               G_context.msg_info.raw_msg_len) != CX_OK ||
-                cx_hash_final((cx_hash_t *) &cx_sha256, G_context.msg_info.m_hash) != CX_OK) {
-                return io_send_sw(SW_HASH_FAIL);
-            }
+        char len[MSG_LEN_MAX_CHARS];
+        snprintf(len, sizeof(len), "%u", G_context.msg_info.raw_msg_len);
 
-            PRINTF("Hash: %.*H\n", sizeof(G_context.msg_info.m_hash), G_context.msg_info.m_hash);
-            return ui_display_message();
+        if (cx_hash_update((cx_hash_t *) &cx_sha256, SIGN_MAGIC, sizeof(SIGN_MAGIC)) != CX_OK ||
+            cx_hash_update((cx_hash_t *) &cx_sha256, (uint8_t *) len, strlen(len)) != CX_OK ||
+            cx_hash_update((cx_hash_t *) &cx_sha256,
+                           G_context.msg_info.raw_msg,
+                           G_context.msg_info.raw_msg_len) != CX_OK ||
+            cx_hash_final((cx_hash_t *) &cx_sha256, G_context.msg_info.m_hash) != CX_OK) {
+            return io_send_sw(SW_HASH_FAIL);
         }
+
+        PRINTF("Hash: %.*H\n", sizeof(G_context.msg_info.m_hash), G_context.msg_info.m_hash);
+        return ui_display_message();
     }
-    return 0;
 }
\ No newline at end of file
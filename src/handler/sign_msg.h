@@ -18,9 +18,13 @@
  * @param[in]     chunk
  *   Index number of the APDU chunk.
  * @param[in]       more
- *   Whether more APDU chunk to be received or not.
+ *   Whether more APDU chunk to be received or not. A first APDU chunk which is also the
+ *   last one holds the BIP32 path followed by the whole message.
+ * @param[in]       in_session
+ *   Whether the first APDU chunk uses the BIP32 path of the session and already holds
+ *   message data.
  *
  * @return zero or positive integer if success, negative integer otherwise.
  *
  */
-int handler_sign_message(buffer_t *cdata, uint8_t chunk, bool more);
+int handler_sign_message(buffer_t *cdata, uint8_t chunk, bool more, bool in_session);
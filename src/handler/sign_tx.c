@@ -23,85 +23,228 @@
 #include "os.h"
 #include "cx.h"
 #include "buffer.h"
+#include "macros.h"
 
 #include "sign_tx.h"
+#include "session.h"
 #include "sw.h"
 #include "globals.h"
 #include "display.h"
 #include "tx_types.h"
 #include "../transaction/deserialize.h"
 #include "../transaction/utils.h"
+#include "../transaction/template.h"
 #include "../address.h"
+#include "../tx_queue.h"
 
 static int handler_hash_tx_and_display_tx(bool is_blind_signing);
+static int handler_queue_tx(transaction_ctx_t *tx_ctx, bool is_blind_signing);
 
-int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
-    if (chunk == 0) {  // first APDU, parse BIP32 path
-        explicit_bzero(&G_context, sizeof(G_context));
-        G_context.req_type = CONFIRM_TRANSACTION;
-        G_context.state = STATE_NONE;
-
-        if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
-            !buffer_read_bip32_path(cdata,
-                                    G_context.bip32_path,
-                                    (size_t) G_context.bip32_path_len)) {
-            return io_send_sw(SW_WRONG_DATA_LENGTH);
-        }
-        if (!is_valid_bip44_prefix(G_context.bip32_path, G_context.bip32_path_len)) {
-            return io_send_sw(SW_INVALID_PATH);
-        }
-        return io_send_sw(SW_OK);
+#ifdef TX_QUEUE_STAGING
+// While a queued review is displayed, the next upload goes to the staging slot
+static uint16_t handler_stage_tx(buffer_t *cdata, bool in_session) {
+    if (G_tx_queue.staged_ready || G_tx_queue.pending_num >= TX_QUEUE_MAX_NUM) {
+        return SW_BAD_STATE;
+    }
+    tx_queue_drop_staging();
+
+    uint16_t sw = session_read_signer(cdata,
+                                      in_session,
+                                      G_tx_queue.bip32_path,
+                                      &G_tx_queue.bip32_path_len,
+                                      G_tx_queue.signer_address,
+                                      sizeof(G_tx_queue.signer_address),
+                                      NULL);
+    if (sw != SW_OK) {
+        tx_queue_drop_staging();
+        return sw;
+    }
+    cx_sha256_init(&G_tx_queue.staged.hash_ctx);
+    transaction_parser_init(&G_tx_queue.staged.parser);
+    G_tx_queue.staging = true;
+    return SW_OK;
+}
+#else
+// Without a staging slot, the next upload waits for the user to answer the queued review
+static uint16_t handler_stage_tx(buffer_t *cdata, bool in_session) {
+    UNUSED(cdata);
+    UNUSED(in_session);
+    return SW_BAD_STATE;
+}
+#endif
+
+// A failed upload into the staging slot is dropped, the chunks which follow it are refused
+static int handler_tx_error(uint16_t sw) {
+    if (G_tx_queue.staging) {
+        tx_queue_drop_staging();
+    }
+    return io_send_sw(sw);
+}
 
-    } else {  // parse transaction
+static uint16_t handler_start_tx(buffer_t *cdata, bool in_session) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    G_context.req_type = CONFIRM_TRANSACTION;
+    G_context.state = STATE_NONE;
+    if (G_tx_queue.staging) {
+        tx_queue_drop_staging();
+    }
 
-        if (G_context.req_type != CONFIRM_TRANSACTION) {
-            return io_send_sw(SW_BAD_STATE);
+    uint16_t sw = session_read_signer(cdata,
+                                      in_session,
+                                      G_context.bip32_path,
+                                      &G_context.bip32_path_len,
+                                      G_context.signer_address,
+                                      sizeof(G_context.signer_address),
+                                      NULL);
+    if (sw != SW_OK) {
+        return sw;
+    }
+    cx_sha256_init(&G_context.tx_info.hash_ctx);
+    transaction_parser_init(&G_context.tx_info.parser);
+    return SW_OK;
+}
+
+uint16_t sign_tx_append_chunk(transaction_ctx_t *tx_ctx, buffer_t *cdata, bool encoded) {
+    size_t raw_tx_len = tx_ctx->raw_tx_len;
+    if (encoded) {
+        if (!tx_template_decode(&tx_ctx->template_ctx,
+                                cdata,
+                                tx_ctx->raw_tx,
+                                sizeof(tx_ctx->raw_tx),
+                                &raw_tx_len)) {
+            return SW_TX_PARSING_FAIL;
         }
-        if (G_context.tx_info.raw_tx_len + cdata->size > sizeof(G_context.tx_info.raw_tx)) {
-            return io_send_sw(SW_WRONG_TX_LENGTH);
+    } else {
+        size_t chunk_len = cdata->size - cdata->offset;
+        if (raw_tx_len + chunk_len > sizeof(tx_ctx->raw_tx)) {
+            return SW_WRONG_TX_LENGTH;
         }
-        if (!buffer_move(cdata,
-                         G_context.tx_info.raw_tx + G_context.tx_info.raw_tx_len,
-                         cdata->size)) {
-            return io_send_sw(SW_TX_PARSING_FAIL);
+        if (!buffer_move(cdata, tx_ctx->raw_tx + raw_tx_len, chunk_len)) {
+            return SW_TX_PARSING_FAIL;
         }
-        G_context.tx_info.raw_tx_len += cdata->size;
-        if (more) {
-            // more APDUs with transaction part are expected.
-            // Send a SW_OK to signal that we have received the chunk
-            return io_send_sw(SW_OK);
+        raw_tx_len += chunk_len;
+    }
+    // Hash the chunk as it lands so only the finalization is left for the last APDU
+    if (cx_hash_update((cx_hash_t *) &tx_ctx->hash_ctx,
+                       tx_ctx->raw_tx + tx_ctx->raw_tx_len,
+                       raw_tx_len - tx_ctx->raw_tx_len) != CX_OK) {
+        return SW_HASH_FAIL;
+    }
+    tx_ctx->raw_tx_len = raw_tx_len;
+    return SW_OK;
+}
+
+int handler_sign_tx(buffer_t *cdata,
+                    uint8_t chunk,
+                    bool more,
+                    bool queued,
+                    bool in_session,
+                    bool encoded) {
+    if (chunk == 0) {  // first APDU, parse BIP32 path or take the one of the session
+        uint16_t sw = G_tx_queue.reviewing ? handler_stage_tx(cdata, in_session)
+                                           : handler_start_tx(cdata, in_session);
+        // In a session, or when it is also the last one, the first APDU holds transaction data
+        if (sw != SW_OK || (!in_session && more)) {
+            return io_send_sw(sw);
+        }
+    }
+
+    // parse transaction
+    transaction_ctx_t *tx_ctx = &G_context.tx_info;
+#ifdef TX_QUEUE_STAGING
+    if (G_tx_queue.staging) {
+        tx_ctx = &G_tx_queue.staged;
+    }
+#endif
+    bool busy = G_tx_queue.staging ? G_tx_queue.staged_ready
+                                   : (G_context.req_type != CONFIRM_TRANSACTION ||
+                                      G_context.state != STATE_NONE);
+    if (busy) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    uint16_t sw = sign_tx_append_chunk(tx_ctx, cdata, encoded);
+    if (sw != SW_OK) {
+        return handler_tx_error(sw);
+    }
 
-        } else {
-            // last APDU for this transaction, let's parse, display and request a sign confirmation
+    // Parse what has arrived so far, the parser resumes where the previous chunk stopped
+    buffer_t buf = {.ptr = tx_ctx->raw_tx, .size = tx_ctx->raw_tx_len, .offset = 0};
+    parser_status_e status =
+        transaction_parser_feed(&tx_ctx->parser, &buf, !more, &tx_ctx->transaction);
+    PRINTF("parse_status: %d\n", status);
 
-            buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
-                            .size = G_context.tx_info.raw_tx_len,
-                            .offset = 0};
+    bool is_blind = (status == PARSING_TX_NOT_DEFINED && N_storage.blind_signed_allowed);
+    if (status != PARSING_OK && !is_blind) {
+        return handler_tx_error(SW_TX_PARSING_FAIL);
+    }
+    if (more) {
+        // more APDUs with transaction part are expected.
+        // Send a SW_OK to signal that we have received the chunk
+        return io_send_sw(SW_OK);
 
-            parser_status_e status = transaction_deserialize(&buf, &G_context.tx_info.transaction);
-            PRINTF("parse_status: %d\n", status);
+    } else if (queued) {
+        // last APDU, answered before the review
+        return handler_queue_tx(tx_ctx, is_blind);
 
-            bool is_blind = (status == PARSING_TX_NOT_DEFINED && N_storage.blind_signed_allowed);
-            return (status != PARSING_OK && !is_blind) ? io_send_sw(SW_TX_PARSING_FAIL)
-                                                       : handler_hash_tx_and_display_tx(is_blind);
-        }
+    } else if (G_tx_queue.staging) {
+        // the host cannot wait for a review which has not started yet
+        return handler_tx_error(SW_BAD_STATE);
+
+    } else {
+        // last APDU for this transaction, display and request a sign confirmation
+        return handler_hash_tx_and_display_tx(is_blind);
     }
-    return 0;
 }
 
-static int handler_hash_tx_and_display_tx(bool is_blind_signing) {
+bool sign_tx_hash_final(cx_sha256_t *hash_ctx, uint8_t m_hash[static CX_SHA256_SIZE]) {
+    // The raw transaction has already been fed chunk by chunk into `hash_ctx`,
+    // only the finalization and the two outer 32-byte hashes remain.
     uint8_t second_hash[CX_SHA256_SIZE];
-    bool res = cx_sha256_hash(G_context.tx_info.raw_tx,
-                              G_context.tx_info.raw_tx_len,
-                              G_context.tx_info.m_hash) == CX_OK &&
-               cx_sha256_hash(G_context.tx_info.m_hash, CX_SHA256_SIZE, second_hash) == CX_OK &&
-               cx_sha256_hash(second_hash, CX_SHA256_SIZE, G_context.tx_info.m_hash) == CX_OK;
+    bool res = cx_hash_final((cx_hash_t *) hash_ctx, m_hash) == CX_OK &&
+               cx_sha256_hash(m_hash, CX_SHA256_SIZE, second_hash) == CX_OK &&
+               cx_sha256_hash(second_hash, CX_SHA256_SIZE, m_hash) == CX_OK;
 
     explicit_bzero(&second_hash, sizeof(second_hash));
-    if (!res) {
+    return res;
+}
+
+static int handler_hash_tx_and_display_tx(bool is_blind_signing) {
+    if (!sign_tx_hash_final(&G_context.tx_info.hash_ctx, G_context.tx_info.m_hash)) {
         return io_send_sw(SW_HASH_FAIL);
     } else {
         G_context.state = STATE_PARSED;
         return ui_display_transaction(is_blind_signing);
     }
-}
\ No newline at end of file
+}
+
+// The result of a queued transaction is read with SIGN_TX_RESULT once the user has answered
+static int handler_queue_tx(transaction_ctx_t *tx_ctx, bool is_blind_signing) {
+    if (G_tx_queue.pending_num >= TX_QUEUE_MAX_NUM) {
+        return handler_tx_error(SW_BAD_STATE);
+    }
+    if (!sign_tx_hash_final(&tx_ctx->hash_ctx, tx_ctx->m_hash)) {
+        return handler_tx_error(SW_HASH_FAIL);
+    }
+
+    if (G_tx_queue.staging) {
+        G_tx_queue.staging = false;
+        G_tx_queue.staged_ready = true;
+        G_tx_queue.staged_blind = is_blind_signing;
+        G_tx_queue.pending_num++;
+        // The previous review may have been answered during the upload
+        if (!G_tx_queue.reviewing) {
+            tx_queue_review_staged();
+        }
+        return io_send_sw(SW_OK);
+    }
+
+    G_context.state = STATE_PARSED;
+    G_tx_queue.reviewing = true;
+    uint16_t sw = ui_review_transaction(is_blind_signing);
+    if (sw != SW_OK) {
+        G_tx_queue.reviewing = false;
+        return io_send_sw(sw);
+    }
+    G_tx_queue.pending_num++;
+    return io_send_sw(SW_OK);
+}
@@ -4,6 +4,9 @@
 #include <stdbool.h>  // bool
 
 #include "buffer.h"
+#include "lcx_sha256.h"
+
+#include "types.h"
 
 /**
  * Handler for SIGN_TX command. If successfully parse BIP32 path
@@ -17,9 +20,53 @@
  * @param[in]     chunk
  *   Index number of the APDU chunk.
  * @param[in]       more
- *   Whether more APDU chunk to be received or not.
+ *   Whether more APDU chunk to be received or not. A first APDU chunk which is also the
+ *   last one holds the BIP32 path followed by the whole transaction.
+ * @param[in]       queued
+ *   Whether the last APDU chunk is answered at once, the review being queued and its result
+ *   read with SIGN_TX_RESULT. While a queued review is displayed, the next transaction is
+ *   received into the staging slot of G_tx_queue and must be queued too.
+ * @param[in]       in_session
+ *   Whether the first APDU chunk uses the BIP32 path of the session and already holds
+ *   transaction data.
+ * @param[in]       encoded
+ *   Whether the transaction data of the APDU chunk is template encoded.
  *
  * @return zero or positive integer if success, negative integer otherwise.
  *
  */
-int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more);
\ No newline at end of file
+int handler_sign_tx(buffer_t *cdata,
+                    uint8_t chunk,
+                    bool more,
+                    bool queued,
+                    bool in_session,
+                    bool encoded);
+
+/**
+ * Append a chunk of transaction data to the raw transaction and to its running hash.
+ *
+ * @param[in,out] tx_ctx
+ *   Transaction context receiving the chunk.
+ * @param[in,out] cdata
+ *   Command data, the chunk is what is left to read.
+ * @param[in]     encoded
+ *   Whether the chunk is template encoded, the canonical bytes being rebuilt from it.
+ *
+ * @return SW_OK if success, the status word of the failure otherwise.
+ *
+ */
+uint16_t sign_tx_append_chunk(transaction_ctx_t *tx_ctx, buffer_t *cdata, bool encoded);
+
+/**
+ * Finalize the hash of a transaction fed chunk by chunk into a SHA-256 context, which is
+ * signed as SHA256(SHA256(SHA256(raw_tx))).
+ *
+ * @param[in,out] hash_ctx
+ *   SHA-256 context of the raw transaction.
+ * @param[out] m_hash
+ *   Message hash digest.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool sign_tx_hash_final(cx_sha256_t *hash_ctx, uint8_t m_hash[static CX_SHA256_SIZE]);
@@ -0,0 +1,140 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // explicit_bzero
+
+#include "os.h"
+#include "cx.h"
+#include "io.h"
+#include "buffer.h"
+
+#include "sign_tx_batch.h"
+#include "sign_tx.h"
+#include "session.h"
+#include "sw.h"
+#include "globals.h"
+#include "display.h"
+#include "send_response.h"
+#include "tx_types.h"
+#include "../transaction/deserialize.h"
+#include "../transaction/batch.h"
+
+// The template decoder state is kept, the next transaction can repeat a payer or from
+static void batch_tx_init(void) {
+    G_context.batch_info.tx_info.raw_tx_len = 0;
+    cx_sha256_init(&G_context.batch_info.tx_info.hash_ctx);
+    transaction_parser_init(&G_context.batch_info.tx_info.parser);
+}
+
+static int batch_start(buffer_t *cdata) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    G_context.req_type = CONFIRM_BATCH;
+    G_context.state = STATE_NONE;
+
+    // Every transfer of the batch must be from the script hash of the signer
+    uint16_t sw = session_read_signer(cdata,
+                                      false,
+                                      G_context.bip32_path,
+                                      &G_context.bip32_path_len,
+                                      G_context.signer_address,
+                                      sizeof(G_context.signer_address),
+                                      G_context.batch_info.summary.signer);
+    if (sw != SW_OK) {
+        return io_send_sw(sw);
+    }
+
+    batch_tx_init();
+    return io_send_sw(SW_OK);
+}
+
+static int batch_add_chunk(buffer_t *cdata, bool more, bool encoded) {
+    tx_batch_t *summary = &G_context.batch_info.summary;
+
+    if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_NONE) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    if (summary->tx_count == BATCH_TX_MAX_NUM) {
+        return io_send_sw(SW_INVALID_TRANSACTION);
+    }
+    uint16_t sw = sign_tx_append_chunk(&G_context.batch_info.tx_info, cdata, encoded);
+    if (sw != SW_OK) {
+        return io_send_sw(sw);
+    }
+
+    buffer_t buf = {.ptr = G_context.batch_info.tx_info.raw_tx,
+                    .size = G_context.batch_info.tx_info.raw_tx_len,
+                    .offset = 0};
+    parser_status_e status = transaction_parser_feed(&G_context.batch_info.tx_info.parser,
+                                                     &buf,
+                                                     !more,
+                                                     &G_context.batch_info.tx_info.transaction);
+    PRINTF("parse_status: %d\n", status);
+
+    // A batch is reviewed from its summary only, blind signing is never allowed
+    if (status != PARSING_OK) {
+        return io_send_sw(SW_TX_PARSING_FAIL);
+    }
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    // Last chunk of the transaction, keep its hash and its share of the summary
+    bool res = sign_tx_hash_final(&G_context.batch_info.tx_info.hash_ctx,
+                                  G_context.batch_info.m_hash[summary->tx_count]);
+    bool added = res && batch_add_transaction(summary, &G_context.batch_info.tx_info.transaction);
+    batch_tx_init();
+    if (!res) {
+        return io_send_sw(SW_HASH_FAIL);
+    }
+    if (!added) {
+        return io_send_sw(SW_INVALID_TRANSACTION);
+    }
+    return io_send_sw(SW_OK);
+}
+
+int handler_sign_tx_batch(buffer_t *cdata, uint8_t step, bool more, bool encoded) {
+    switch (step) {
+        case P1_BATCH_PATH:
+            return batch_start(cdata);
+        case P1_BATCH_TX:
+            return batch_add_chunk(cdata, more, encoded);
+        case P1_BATCH_END:
+            // A transaction whose last chunk has not been received is not part of the batch
+            if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_NONE ||
+                G_context.batch_info.tx_info.raw_tx_len != 0 || G_context.batch_info.summary.tx_count == 0) {
+                return io_send_sw(SW_BAD_STATE);
+            }
+            G_context.state = STATE_PARSED;
+            return ui_display_batch();
+        case P1_BATCH_SIGNATURES: {
+            uint8_t first = 0;
+            if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_APPROVED) {
+                return io_send_sw(SW_BAD_STATE);
+            }
+            if (!buffer_read_u8(cdata, &first) ||
+                first >= G_context.batch_info.summary.tx_count) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+            return helper_batch_send_response_sig(first);
+        }
+        default:
+            return io_send_sw(SW_WRONG_P1P2);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "buffer.h"
+
+/**
+ * Steps of the SIGN_TX_BATCH command, in P1.
+ */
+#define P1_BATCH_PATH       0x00  /// BIP32 path, starts a new batch
+#define P1_BATCH_TX         0x01  /// chunk of a transaction, P2_LAST on its last chunk
+#define P1_BATCH_END        0x02  /// no more transactions, display the summary
+#define P1_BATCH_SIGNATURES 0x03  /// signatures of the approved batch
+
+/**
+ * Handler for SIGN_TX_BATCH command. Parse and hash each transaction of the batch as it
+ * arrives, keeping only its hash and its share of the summary, display the summary once
+ * and sign every transaction with a single derivation of the private key.
+ *
+ * @see G_context.batch_info and G_context.batch_sig.
+ *
+ * cdata = path_len (1) || path (4 * path_len)       for P1_BATCH_PATH
+ *       | raw or template encoded transaction chunk  for P1_BATCH_TX
+ *       | empty                                      for P1_BATCH_END
+ *       | index of the first signature (1)           for P1_BATCH_SIGNATURES
+ *
+ * The response to the approval and to P1_BATCH_SIGNATURES is
+ * number of signatures (1) || (signature_len (1) || signature || v (1)) for each of them,
+ * with as many signatures as fit in one APDU response.
+ *
+ * @param[in,out] cdata
+ *   Command data.
+ * @param[in]     step
+ *   Step of the command, one of the P1_BATCH_* values.
+ * @param[in]     more
+ *   Whether more APDU chunk of the current transaction are to be received or not.
+ * @param[in]     encoded
+ *   Whether the transaction chunk is template encoded.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_batch(buffer_t *cdata, uint8_t step, bool more, bool encoded);
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>  // uint*_t
+#include <string.h>  // memmove, explicit_bzero
+
+#include "io.h"
+
+#include "sign_tx_result.h"
+#include "globals.h"
+#include "sw.h"
+#include "types.h"
+#include "send_response.h"
+
+int handler_sign_tx_result() {
+    if (G_tx_queue.results_num == 0) {
+        return io_send_sw(G_tx_queue.pending_num != 0 ? SW_REVIEW_PENDING : SW_BAD_STATE);
+    }
+
+    tx_result_t result = G_tx_queue.results[0];
+    G_tx_queue.results_num--;
+    G_tx_queue.pending_num--;
+    memmove(&G_tx_queue.results[0],
+            &G_tx_queue.results[1],
+            G_tx_queue.results_num * sizeof(tx_result_t));
+    explicit_bzero(&G_tx_queue.results[G_tx_queue.results_num], sizeof(tx_result_t));
+
+    int ret = result.sw == SW_OK ? helper_tx_send_response_result(&result) : io_send_sw(result.sw);
+    explicit_bzero(&result, sizeof(result));
+    return ret;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * Handler for SIGN_TX_RESULT command. Send the result of the oldest queued transaction
+ * whose result has not been read yet, in the order of the uploads.
+ *
+ * @see G_tx_queue.results.
+ *
+ * response = signature_len (1) || signature (signature_len) || v (1) with SW_OK if signed,
+ * SW_DENY if refused, SW_REVIEW_PENDING if still under review.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_result(void);
@@ -15,9 +15,10 @@
  *  limitations under the License.
  *****************************************************************************/
 
-#include <stddef.h>  // size_t
-#include <stdint.h>  // uint*_t
-#include <string.h>  // memmove
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memmove
 
 #include "buffer.h"
 
@@ -25,17 +26,47 @@
 #include "constants.h"
 #include "globals.h"
 #include "sw.h"
+#include "../address.h"
+
+#define MAX_BATCH_RESPONSE_LEN 255  // 3 signatures of at most MAX_SIGNATURE_LEN bytes
 
 int helper_send_response_pubkey() {
     uint8_t resp[1 + PUBKEY_LEN + 1 + CHAINCODE_LEN] = {0};
     size_t offset = 0;
+    bool result = true;
 
-    resp[offset++] = PUBKEY_LEN;
-    memmove(resp + offset, G_context.pk_info.raw_public_key, PUBKEY_LEN);
-    offset += PUBKEY_LEN;
-    resp[offset++] = CHAINCODE_LEN;
-    memmove(resp + offset, G_context.pk_info.chain_code, CHAINCODE_LEN);
-    offset += CHAINCODE_LEN;
+    switch (G_context.pk_info.format) {
+        case PUBKEY_FORMAT_COMPRESSED:
+            resp[offset++] = COMPRESSED_KEY_LEN;
+            result = compress_public_key(G_context.pk_info.raw_public_key, resp + offset);
+            offset += COMPRESSED_KEY_LEN;
+            break;
+        case PUBKEY_FORMAT_SCRIPT_HASH:
+            resp[offset++] = ADDRESS_SCRIPT_HASH_LEN;
+            result = convert_uncompressed_pubkey_to_script_hash(G_context.pk_info.raw_public_key,
+                                                                resp + offset);
+            offset += ADDRESS_SCRIPT_HASH_LEN;
+            break;
+        case PUBKEY_FORMAT_ADDRESS:
+            // the null terminator is written but not sent
+            resp[offset++] = BASE58_ADDRESS_LEN;
+            result = convert_uncompressed_pubkey_to_address((char *) resp + offset,
+                                                            sizeof(resp) - offset,
+                                                            G_context.pk_info.raw_public_key);
+            offset += BASE58_ADDRESS_LEN;
+            break;
+        default:
+            resp[offset++] = PUBKEY_LEN;
+            memmove(resp + offset, G_context.pk_info.raw_public_key, PUBKEY_LEN);
+            offset += PUBKEY_LEN;
+            resp[offset++] = CHAINCODE_LEN;
+            memmove(resp + offset, G_context.pk_info.chain_code, CHAINCODE_LEN);
+            offset += CHAINCODE_LEN;
+            break;
+    }
+    if (!result) {
+        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+    }
 
     return io_send_response_pointer(resp, offset, SW_OK);
 }
@@ -52,6 +83,18 @@ int helper_tx_send_response_sig() {
     return io_send_response_pointer(resp, offset, SW_OK);
 }
 
+int helper_tx_send_response_result(const tx_result_t *result) {
+    uint8_t resp[1 + MAX_SIGNATURE_LEN + 1] = {0};
+    size_t offset = 0;
+
+    resp[offset++] = result->signature_len;
+    memmove(resp + offset, result->signature, result->signature_len);
+    offset += result->signature_len;
+    resp[offset++] = result->v;
+
+    return io_send_response_pointer(resp, offset, SW_OK);
+}
+
 int helper_personal_msg_send_response_sig() {
     uint8_t resp[1 + MAX_SIGNATURE_LEN + 1] = {0};
     size_t offset = 0;
@@ -62,4 +105,25 @@ int helper_personal_msg_send_response_sig() {
     resp[offset++] = (uint8_t) G_context.msg_info.v;
 
     return io_send_response_pointer(resp, offset, SW_OK);
-}
\ No newline at end of file
+}
+
+int helper_batch_send_response_sig(uint8_t first) {
+    uint8_t resp[MAX_BATCH_RESPONSE_LEN] = {0};
+    size_t offset = 1;
+    uint8_t num = 0;
+
+    for (uint8_t i = first; i < G_context.batch_info.summary.tx_count; i++) {
+        uint8_t sig_len = G_context.batch_info.sig.signature_len[i];
+        if (offset + 1 + sig_len + 1 > sizeof(resp)) {
+            break;
+        }
+        resp[offset++] = sig_len;
+        memmove(resp + offset, G_context.batch_info.sig.signature[i], sig_len);
+        offset += sig_len;
+        resp[offset++] = G_context.batch_info.sig.v[i];
+        num++;
+    }
+    resp[0] = num;
+
+    return io_send_response_pointer(resp, offset, SW_OK);
+}
@@ -3,6 +3,8 @@
 #include "os.h"
 #include "macros.h"
 
+#include "types.h"
+
 /**
  * Length of public key.
  */
@@ -13,13 +15,18 @@
 #define CHAINCODE_LEN (MEMBER_SIZE(pubkey_ctx_t, chain_code))
 
 /**
- * Helper to send APDU response with public key and chain code.
+ * Helper to send APDU response with public key and chain code, or with the compact form of
+ * the key selected by G_context.pk_info.format.
  *
  * response = PUBKEY_LEN (1) ||
  *            G_context.pk_info.public_key (PUBKEY_LEN) ||
  *            CHAINCODE_LEN (1) ||
  *            G_context.pk_info.chain_code (CHAINCODE_LEN)
  *
+ * or response = COMPRESSED_KEY_LEN (1) || compressed public key (COMPRESSED_KEY_LEN)
+ * or response = ADDRESS_SCRIPT_HASH_LEN (1) || script hash (ADDRESS_SCRIPT_HASH_LEN)
+ * or response = BASE58_ADDRESS_LEN (1) || base58 address (BASE58_ADDRESS_LEN)
+ *
  * @return zero or positive integer if success, -1 otherwise.
  *
  */
@@ -37,6 +44,21 @@ int helper_send_response_pubkey(void);
  *
  */
 int helper_tx_send_response_sig(void);
+
+/**
+ * Helper to send APDU response with the signature of a queued transaction.
+ *
+ * response = result->signature_len (1) ||
+ *            result->signature (result->signature_len) ||
+ *            result->v (1)
+ *
+ * @param[in] result
+ *   Result of the queued review, signed.
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int helper_tx_send_response_result(const tx_result_t *result);
 /**
  * Helper to send APDU response with signature and v (parity of
  * y-coordinate of R). for personal msg
@@ -49,3 +71,20 @@ int helper_tx_send_response_sig(void);
  *
  */
 int helper_personal_msg_send_response_sig(void);
+
+/**
+ * Helper to send APDU response with the signatures of a batch, from the given one and as
+ * many as fit in one APDU response.
+ *
+ * response = number of signatures (1) ||
+ *            G_context.batch_sig.signature_len[i] (1) ||
+ *            G_context.batch_sig.signature[i] (G_context.batch_sig.signature_len[i]) ||
+ *            G_context.batch_sig.v[i] (1) || ...
+ *
+ * @param[in] first
+ *   Index of the first signature, less than the number of transactions of the batch.
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int helper_batch_send_response_sig(uint8_t first);
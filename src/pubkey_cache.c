@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <string.h>  // memcpy, memcmp, explicit_bzero
+
+#include "bip32.h"
+#include "cx.h"
+#include "crypto_helpers.h"
+
+#include "pubkey_cache.h"
+
+#define PUBKEY_CACHE_SIZE 8
+#define HARDENED_INDEX    0x80000000U
+#define EC_SCALAR_LEN     32
+
+/**
+ * Structure for a derived path, the public part of its node only.
+ */
+typedef struct {
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t path_len;  // 0 for a free entry
+    uint8_t raw_public_key[UNCOMPRESSED_KEY_LEN];
+    uint8_t chain_code[CHAIN_CODE_LEN];
+    uint32_t last_used;  // value of g_pubkey_cache_clock at the last hit
+} pubkey_cache_entry_t;
+
+static pubkey_cache_entry_t g_pubkey_cache[PUBKEY_CACHE_SIZE];
+static uint32_t g_pubkey_cache_clock;
+
+// Generator of secp256r1, uncompressed
+static const uint8_t SECP256R1_G[UNCOMPRESSED_KEY_LEN] = {
+    0x04, 0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4,
+    0x40, 0xf2, 0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8,
+    0x98, 0xc2, 0x96, 0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a,
+    0x7c, 0x0f, 0x9e, 0x16, 0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40,
+    0x68, 0x37, 0xbf, 0x51, 0xf5};
+
+// Order of secp256r1, big endian
+static const uint8_t SECP256R1_N[EC_SCALAR_LEN] = {
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+
+/**
+ * Public child key derivation of BIP32, for a non-hardened index:
+ * I = HMAC-SHA512(c_par, ser_P(K_par) || ser_32(index)), K = I_L * G + K_par, c = I_R.
+ * Fails in the unlikely cases where I_L is not a valid scalar or K is the point at infinity,
+ * the caller then falls back to the derivation in the secure element.
+ */
+static cx_err_t derive_public_child(const uint8_t parent_key[static UNCOMPRESSED_KEY_LEN],
+                                    const uint8_t parent_chain_code[static CHAIN_CODE_LEN],
+                                    uint32_t index,
+                                    uint8_t child_key[static UNCOMPRESSED_KEY_LEN],
+                                    uint8_t child_chain_code[static CHAIN_CODE_LEN]) {
+    uint8_t data[COMPRESSED_KEY_LEN + sizeof(uint32_t)];
+    if (!compress_public_key(parent_key, data)) {
+        return CX_INVALID_PARAMETER;
+    }
+    data[COMPRESSED_KEY_LEN] = (uint8_t) (index >> 24);
+    data[COMPRESSED_KEY_LEN + 1] = (uint8_t) (index >> 16);
+    data[COMPRESSED_KEY_LEN + 2] = (uint8_t) (index >> 8);
+    data[COMPRESSED_KEY_LEN + 3] = (uint8_t) index;
+
+    uint8_t hmac[2 * EC_SCALAR_LEN];
+    uint8_t point[UNCOMPRESSED_KEY_LEN];
+    memcpy(point, SECP256R1_G, sizeof(point));
+
+    // cx_hmac_sha512 returns the length of the MAC, 0 on failure
+    cx_err_t error = cx_hmac_sha512(parent_chain_code,
+                                    CHAIN_CODE_LEN,
+                                    data,
+                                    sizeof(data),
+                                    hmac,
+                                    sizeof(hmac)) == sizeof(hmac)
+                         ? CX_OK
+                         : CX_INTERNAL_ERROR;
+    if (error == CX_OK) {
+        static const uint8_t zero[EC_SCALAR_LEN] = {0};
+        if (memcmp(hmac, SECP256R1_N, EC_SCALAR_LEN) >= 0 ||
+            memcmp(hmac, zero, EC_SCALAR_LEN) == 0) {
+            error = CX_INVALID_PARAMETER;
+        }
+    }
+    if (error == CX_OK) {
+        error = cx_ecfp_scalar_mult_no_throw(CX_CURVE_256R1, point, hmac, EC_SCALAR_LEN);
+    }
+    if (error == CX_OK) {
+        error = cx_ecfp_add_point_no_throw(CX_CURVE_256R1, child_key, point, parent_key);
+    }
+    if (error == CX_OK) {
+        memcpy(child_chain_code, &hmac[EC_SCALAR_LEN], CHAIN_CODE_LEN);
+    }
+
+    explicit_bzero(hmac, sizeof(hmac));
+    explicit_bzero(point, sizeof(point));
+    return error;
+}
+
+static void copy_entry(const pubkey_cache_entry_t *entry,
+                       uint8_t raw_public_key[static UNCOMPRESSED_KEY_LEN],
+                       uint8_t *chain_code) {
+    memcpy(raw_public_key, entry->raw_public_key, UNCOMPRESSED_KEY_LEN);
+    if (chain_code != NULL) {
+        memcpy(chain_code, entry->chain_code, CHAIN_CODE_LEN);
+    }
+}
+
+static pubkey_cache_entry_t *cache_find(const uint32_t *path, size_t path_len) {
+    for (size_t i = 0; i < PUBKEY_CACHE_SIZE; i++) {
+        pubkey_cache_entry_t *entry = &g_pubkey_cache[i];
+        if (entry->path_len == path_len &&
+            memcmp(entry->path, path, path_len * sizeof(path[0])) == 0) {
+            entry->last_used = ++g_pubkey_cache_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void cache_put(const uint32_t *path,
+                      size_t path_len,
+                      const uint8_t raw_public_key[static UNCOMPRESSED_KEY_LEN],
+                      const uint8_t chain_code[static CHAIN_CODE_LEN]) {
+    // Replace a free entry or the least recently used one
+    pubkey_cache_entry_t *victim = &g_pubkey_cache[0];
+    for (size_t i = 1; i < PUBKEY_CACHE_SIZE && victim->path_len != 0; i++) {
+        if (g_pubkey_cache[i].path_len == 0 ||
+            g_pubkey_cache[i].last_used < victim->last_used) {
+            victim = &g_pubkey_cache[i];
+        }
+    }
+    memcpy(victim->raw_public_key, raw_public_key, UNCOMPRESSED_KEY_LEN);
+    memcpy(victim->chain_code, chain_code, CHAIN_CODE_LEN);
+    memcpy(victim->path, path, path_len * sizeof(path[0]));
+    victim->path_len = (uint8_t) path_len;
+    victim->last_used = ++g_pubkey_cache_clock;
+}
+
+static cx_err_t derive_in_secure_element(const uint32_t *path,
+                                         size_t path_len,
+                                         uint8_t raw_public_key[static UNCOMPRESSED_KEY_LEN],
+                                         uint8_t chain_code[static CHAIN_CODE_LEN]) {
+    return bip32_derive_get_pubkey_256(CX_CURVE_256R1,
+                                       path,
+                                       path_len,
+                                       raw_public_key,
+                                       chain_code,
+                                       CX_SHA256);
+}
+
+cx_err_t pubkey_cache_get(const uint32_t *path,
+                          size_t path_len,
+                          uint8_t raw_public_key[static UNCOMPRESSED_KEY_LEN],
+                          uint8_t *chain_code) {
+    if (path == NULL || path_len == 0 || path_len > MAX_BIP32_PATH) {
+        return CX_INVALID_PARAMETER;
+    }
+
+    const pubkey_cache_entry_t *entry = cache_find(path, path_len);
+    if (entry != NULL) {
+        copy_entry(entry, raw_public_key, chain_code);
+        return CX_OK;
+    }
+
+    // Walk up to the deepest ancestor which is cached or ends with a hardened index: an account
+    // is derived once in the secure element, then each of its addresses publicly
+    size_t depth = path_len;
+    while (entry == NULL && depth > 1 && (path[depth - 1] & HARDENED_INDEX) == 0) {
+        depth--;
+        entry = cache_find(path, depth);
+    }
+
+    uint8_t node_key[UNCOMPRESSED_KEY_LEN];
+    uint8_t node_chain_code[CHAIN_CODE_LEN];
+    uint8_t child_key[UNCOMPRESSED_KEY_LEN];
+    uint8_t child_chain_code[CHAIN_CODE_LEN];
+    cx_err_t error = CX_OK;
+    if (entry != NULL) {
+        copy_entry(entry, node_key, node_chain_code);
+    } else {
+        error = derive_in_secure_element(path, depth, node_key, node_chain_code);
+        if (error == CX_OK) {
+            cache_put(path, depth, node_key, node_chain_code);
+        }
+    }
+
+    // Then derive the levels below it one at a time, caching each node
+    for (; error == CX_OK && depth < path_len; depth++) {
+        error = derive_public_child(node_key,
+                                    node_chain_code,
+                                    path[depth],
+                                    child_key,
+                                    child_chain_code);
+        if (error != CX_OK) {
+            error = derive_in_secure_element(path, depth + 1, child_key, child_chain_code);
+        }
+        if (error == CX_OK) {
+            cache_put(path, depth + 1, child_key, child_chain_code);
+            memcpy(node_key, child_key, sizeof(node_key));
+            memcpy(node_chain_code, child_chain_code, sizeof(node_chain_code));
+        }
+    }
+
+    if (error == CX_OK) {
+        memcpy(raw_public_key, node_key, sizeof(node_key));
+        if (chain_code != NULL) {
+            memcpy(chain_code, node_chain_code, sizeof(node_chain_code));
+        }
+    }
+    explicit_bzero(child_key, sizeof(child_key));
+    explicit_bzero(child_chain_code, sizeof(child_chain_code));
+    explicit_bzero(node_chain_code, sizeof(node_chain_code));
+    return error;
+}
+
+void pubkey_cache_clear(void) {
+    explicit_bzero(g_pubkey_cache, sizeof(g_pubkey_cache));
+    g_pubkey_cache_clock = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+
+#include "cx.h"
+
+#include "address.h"
+
+/**
+ * @brief Gets the public key and chain code of a BIP32 path on the secp256r1 curve.
+ *
+ * The last derived paths are kept in RAM, a path found there is copied instead of being
+ * derived again. A path ending with a non-hardened index is derived from the public key and
+ * chain code of its parent, the secure element is only used for hardened levels. Only public
+ * data is cached.
+ *
+ * @param[in] path The BIP32 path.
+ * @param[in] path_len Number of elements of the path, at most MAX_BIP32_PATH.
+ * @param[out] raw_public_key The uncompressed public key.
+ * @param[out] chain_code The chain code, may be NULL.
+ *
+ * @return CX_OK if success, the error of the derivation otherwise.
+ */
+cx_err_t pubkey_cache_get(const uint32_t *path,
+                          size_t path_len,
+                          uint8_t raw_public_key[static UNCOMPRESSED_KEY_LEN],
+                          uint8_t *chain_code);
+
+/**
+ * @brief Clears the cached public keys.
+ */
+void pubkey_cache_clear(void);
@@ -71,4 +71,8 @@
 /**
  * Status word for invalid path.
  */
-#define SW_INVALID_PATH 0xB00B
\ No newline at end of file
+#define SW_INVALID_PATH 0xB00B
+/**
+ * Status word for a queued transaction still under review.
+ */
+#define SW_REVIEW_PENDING 0xB00C
\ No newline at end of file
@@ -0,0 +1,163 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include "amount.h"
+
+#define CHUNK_DIGITS 19
+#define CHUNK_BASE   10000000000000000000ULL  // 10^19, the largest power of 10 below 2^64
+#define PART_DIGITS  9
+#define PART_BASE    1000000000U  // 10^9, the largest power of 10 below 2^32
+
+// An amount has at most 3 chunks of 19 digits, the last one being a single digit
+#define DIGITS_MAX_LEN (3 * CHUNK_DIGITS)
+
+bool amount_add(amount_t *sum, const amount_t *value) {
+    if (sum == NULL || value == NULL) {
+        return false;
+    }
+
+    uint64_t low = sum->low + value->low;
+    uint64_t carry = low < value->low ? 1 : 0;
+    uint64_t high = sum->high + value->high;
+    if (high < value->high || high + carry < high) {
+        return false;
+    }
+
+    sum->high = high + carry;
+    sum->low = low;
+    return true;
+}
+
+void amount_mul_u64(uint64_t a, uint64_t b, amount_t *out) {
+    if (out == NULL) {
+        return;
+    }
+
+    uint64_t a_lo = a & UINT32_MAX;
+    uint64_t a_hi = a >> 32;
+    uint64_t b_lo = b & UINT32_MAX;
+    uint64_t b_hi = b >> 32;
+
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+
+    // sum of the middle terms and the carry of the low one, cannot overflow
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & UINT32_MAX) + lo_hi;
+
+    out->high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    out->low = (cross << 32) | (lo_lo & UINT32_MAX);
+}
+
+// Divide a value by 10^19 in place and return the remainder. The high word of the quotient is
+// at most 1 since 2^64 < 2 * 10^19, the low word is computed by shift-and-subtract instead of a
+// 128-bit division.
+static uint64_t divmod_chunk(amount_t *value) {
+    uint64_t high = value->high >= CHUNK_BASE ? 1 : 0;
+    uint64_t rem = value->high - high * CHUNK_BASE;
+    uint64_t low = 0;
+
+    for (int i = 63; i >= 0; i--) {
+        uint64_t carry = rem >> 63;
+        rem = (rem << 1) | ((value->low >> i) & 1);
+        low <<= 1;
+        if (carry != 0 || rem >= CHUNK_BASE) {
+            rem -= CHUNK_BASE;  // wraps around to the right value when carry is set
+            low |= 1;
+        }
+    }
+
+    value->high = high;
+    value->low = low;
+    return rem;
+}
+
+// Write the 19 digits of a chunk right before `end`, padded with zeros. The chunk is split in
+// parts below 10^9 whose digits only need 32-bit divisions.
+static void chunk_to_digits(uint64_t chunk, char *end) {
+    uint64_t upper = chunk / PART_BASE;
+    uint32_t parts[3] = {(uint32_t) (chunk - upper * PART_BASE),
+                         (uint32_t) (upper % PART_BASE),
+                         (uint32_t) (upper / PART_BASE)};
+
+    for (size_t i = 0; i < 3; i++) {
+        uint32_t part = parts[i];
+        size_t digits = i < 2 ? PART_DIGITS : CHUNK_DIGITS - 2 * PART_DIGITS;
+        for (size_t j = 0; j < digits; j++) {
+            *--end = (char) ('0' + part % 10);
+            part /= 10;
+        }
+    }
+}
+
+bool amount_to_chars(const amount_t *amount, uint8_t decimals, char *out, size_t out_len) {
+    if (amount == NULL || out == NULL || decimals > AMOUNT_MAX_DIGITS) {
+        return false;
+    }
+
+    // Digits of the amount, least significant chunk first from the end of the buffer
+    char digits[DIGITS_MAX_LEN];
+    char *end = digits + sizeof(digits);
+    char *begin = end;
+    amount_t value = *amount;
+    do {
+        chunk_to_digits(divmod_chunk(&value), begin);
+        begin -= CHUNK_DIGITS;
+    } while (value.high != 0 || value.low != 0);
+    while (begin < end - 1 && *begin == '0') {
+        begin++;
+    }
+    size_t len = (size_t) (end - begin);
+
+    // The fraction is the last `decimals` digits, after `lead` zeros if there are not enough
+    // digits. Trim its trailing zeros, all of them if the fraction is zero.
+    size_t lead = decimals > len ? decimals - len : 0;
+    size_t frac_len = decimals;
+    while (frac_len > lead && end[(ptrdiff_t) frac_len - 1 - decimals] == '0') {
+        frac_len--;
+    }
+    if (frac_len == lead) {
+        frac_len = 0;
+    }
+    size_t int_len = len > decimals ? len - decimals : 0;
+
+    size_t total = (int_len > 0 ? int_len : 1) + (frac_len > 0 ? 1 + frac_len : 0);
+    if (out_len < total + 1) {
+        if (out_len > 0) {
+            out[0] = '\0';
+        }
+        return false;
+    }
+
+    // Single pass over the caller's buffer: integer part, decimal point, fraction
+    char *ptr = out;
+    if (int_len == 0) {
+        *ptr++ = '0';
+    }
+    for (size_t i = 0; i < int_len; i++) {
+        *ptr++ = begin[i];
+    }
+    if (frac_len > 0) {
+        *ptr++ = '.';
+        for (size_t i = 0; i < frac_len; i++) {
+            *ptr++ = i < lead ? '0' : begin[int_len + i - lead];
+        }
+    }
+    *ptr = '\0';
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+// Maximum number of decimal digits of an amount, 2^128 - 1 has 39
+#define AMOUNT_MAX_DIGITS 39
+
+/**
+ * Structure for an unsigned 128-bit amount, in the smallest unit of its token.
+ */
+typedef struct {
+    uint64_t high;
+    uint64_t low;
+} amount_t;
+
+/**
+ * Add an amount to another one.
+ *
+ * @param[in,out] sum
+ *   Pointer to the amount to add to, unchanged on overflow.
+ * @param[in] value
+ *   Pointer to the amount to add.
+ * @return true if success, false if the sum does not fit in 128 bits.
+ */
+bool amount_add(amount_t *sum, const amount_t *value);
+
+/**
+ * Multiply two 64-bit integers, the product always fits in an amount.
+ *
+ * @param[in] a
+ *   First factor.
+ * @param[in] b
+ *   Second factor.
+ * @param[out] out
+ *   Pointer to the product.
+ */
+void amount_mul_u64(uint64_t a, uint64_t b, amount_t *out);
+
+/**
+ * Format an amount as a decimal number with a fixed number of decimals, without the trailing
+ * zeros of the fractional part.
+ *
+ * @param[in] amount
+ *   Pointer to the amount.
+ * @param[in] decimals
+ *   Number of decimals of the token, at most AMOUNT_MAX_DIGITS.
+ * @param[out] out
+ *   Buffer to store the null-terminated string.
+ * @param[in] out_len
+ *   Length of the buffer.
+ * @return true if success, false if the buffer is too small.
+ */
+bool amount_to_chars(const amount_t *amount, uint8_t decimals, char *out, size_t out_len);
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <string.h>  // memcmp, memcpy, strcmp
+
+#include "batch.h"
+#include "parse.h"
+#include "utils.h"
+
+#if defined(TEST) || defined(FUZZ)
+#include "assert.h"
+#define LEDGER_ASSERT(x, y) assert(x)
+#else
+#include "ledger_assert.h"
+#endif
+
+static bool batch_add_recipient(tx_batch_t *batch, const uint8_t *recipient) {
+    for (uint8_t i = 0; i < batch->recipients_num; i++) {
+        if (memcmp(batch->recipients[i], recipient, ADDRESS_SCRIPT_HASH_LEN) == 0) {
+            return true;
+        }
+    }
+    if (batch->recipients_num == BATCH_RECIPIENTS_MAX_NUM) {
+        return false;
+    }
+    memcpy(batch->recipients[batch->recipients_num++], recipient, ADDRESS_SCRIPT_HASH_LEN);
+    return true;
+}
+
+static bool batch_add_amount(tx_batch_t *batch, const tx_contract_t *contract, const amount_t *value) {
+    uint8_t i = 0;
+    while (i < batch->tokens_num && (strcmp(batch->tokens[i].ticker, contract->ticker) != 0 ||
+                                     batch->tokens[i].decimals != contract->token_decimals)) {
+        i++;
+    }
+    if (i == batch->tokens_num) {
+        if (batch->tokens_num == BATCH_TOKENS_MAX_NUM) {
+            return false;
+        }
+        batch->tokens[i].ticker = contract->ticker;
+        batch->tokens[i].decimals = contract->token_decimals;
+        batch->tokens[i].total = (amount_t) {0};
+        batch->tokens_num++;
+    }
+    return amount_add(&batch->tokens[i].total, value);
+}
+
+static bool batch_add_transfer(tx_batch_t *batch,
+                               const transaction_t *tx,
+                               const tx_parameter_t *from,
+                               const tx_parameter_t *to,
+                               const tx_parameter_t *amount) {
+    amount_t value;
+    return from->type == PARAM_ADDR && from->len == ADDRESS_SCRIPT_HASH_LEN &&
+           to->type == PARAM_ADDR && to->len == ADDRESS_SCRIPT_HASH_LEN &&
+           memcmp(param_data(tx->raw, from), batch->signer, ADDRESS_SCRIPT_HASH_LEN) == 0 &&
+           convert_param_to_amount(tx->raw, amount, amount->type == PARAM_AMOUNT, &value) &&
+           batch_add_recipient(batch, param_data(tx->raw, to)) &&
+           batch_add_amount(batch, &tx->contract, &value);
+}
+
+static bool batch_add_transfers(tx_batch_t *batch, transaction_t *tx) {
+    const tx_parameter_t *params = tx->method.parameters;
+    tx_parameter_t state[3];
+
+    switch (tx->contract.type) {
+        case NATIVE_CONTRACT:
+            // The transfer states were validated by the parser, they are decoded again here
+            if (tx->method.group.count == 0) {
+                return false;
+            }
+            for (uint16_t i = 0; i < tx->method.group.count; i++) {
+                if (!parse_transfer_state_at(tx, i, state) ||
+                    !batch_add_transfer(batch, tx, &state[0], &state[1], &state[2])) {
+                    return false;
+                }
+            }
+            return true;
+        case NEOVM_CONTRACT:
+            // The arguments are pushed in reverse order: amount, to, from
+            return batch_add_transfer(batch, tx, &params[2], &params[1], &params[0]);
+        case WASMVM_CONTRACT:
+            return batch_add_transfer(batch, tx, &params[0], &params[1], &params[2]);
+        default:
+            return false;
+    }
+}
+
+bool batch_add_transaction(tx_batch_t *batch, transaction_t *tx) {
+    LEDGER_ASSERT(batch != NULL, "NULL batch");
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+
+    if (batch->tx_count == BATCH_TX_MAX_NUM || tx->contract.ticker == NULL ||
+        (tx->method.id != METHOD_ID_TRANSFER && tx->method.id != METHOD_ID_TRANSFER_V2)) {
+        return false;
+    }
+
+    // The recipients are only appended, restoring their number is enough to roll them back
+    const amount_t gas = batch->gas;
+    const uint8_t recipients_num = batch->recipients_num;
+    const uint8_t tokens_num = batch->tokens_num;
+    batch_token_total_t tokens[BATCH_TOKENS_MAX_NUM];
+    memcpy(tokens, batch->tokens, sizeof(tokens));
+
+    amount_t fee;
+    amount_mul_u64(tx->header.gas_price, tx->header.gas_limit, &fee);
+    if (!amount_add(&batch->gas, &fee) || !batch_add_transfers(batch, tx)) {
+        batch->gas = gas;
+        batch->recipients_num = recipients_num;
+        batch->tokens_num = tokens_num;
+        memcpy(batch->tokens, tokens, sizeof(tokens));
+        return false;
+    }
+
+    batch->tx_count++;
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stdint.h>   // uint*_t
+
+#include "tx_types.h"
+#include "amount.h"
+#include "address.h"
+
+// Number of transactions of a batch
+#define BATCH_TX_MAX_NUM 32
+// Number of tokens a batch can transfer
+#define BATCH_TOKENS_MAX_NUM 4
+// Number of distinct recipients of a batch
+#define BATCH_RECIPIENTS_MAX_NUM 32
+
+/**
+ * Structure for the total transferred of a token.
+ */
+typedef struct {
+    const char *ticker;
+    uint8_t decimals;
+    amount_t total;
+} batch_token_total_t;
+
+/**
+ * Structure for the summary of a batch of transfers from a single signer, which is all the
+ * batch review displays. The transactions themselves are not kept.
+ */
+typedef struct {
+    uint8_t signer[ADDRESS_SCRIPT_HASH_LEN];  // script hash every transfer must be from
+    uint8_t tx_count;                         // number of transactions added
+    amount_t gas;                             // total gas fee, in the smallest unit of ONG
+    uint8_t tokens_num;
+    batch_token_total_t tokens[BATCH_TOKENS_MAX_NUM];
+    uint8_t recipients_num;
+    uint8_t recipients[BATCH_RECIPIENTS_MAX_NUM][ADDRESS_SCRIPT_HASH_LEN];
+} tx_batch_t;
+
+/**
+ * Add a parsed transaction to the summary of a batch.
+ * Only the transfer and transferV2 methods of the registered tokens are accepted, each of their
+ * transfers must be from the signer of the batch.
+ *
+ * @param[in,out] batch
+ *   Pointer to the summary, unchanged if the transaction is rejected.
+ * @param[in,out] tx
+ *   Pointer to the parsed transaction, its transfer states are decoded again.
+ * @return true if success, false if the transaction cannot be part of the batch or one of the
+ *   limits of the summary is reached.
+ */
+bool batch_add_transaction(tx_batch_t *batch, transaction_t *tx);
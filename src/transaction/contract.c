@@ -17,151 +17,109 @@
 
 #include <string.h>
 #include "contract.h"
-#include "../ui/types.h"
-void get_native_token_methods(tx_method_signature_t *methods) {
-    static const tx_parameter_type_e transfer_params[] = {PARAM_TRANSFER_STATE_LIST, PARAM_END};
-    static const tx_parameter_type_e transfer_from_params[] = {PARAM_ADDR,
-                                                               PARAM_TRANSFER_STATE,
-                                                               PARAM_END};
-    static const tx_parameter_type_e approve_params[] = {PARAM_ADDR,
-                                                         PARAM_ADDR,
-                                                         PARAM_AMOUNT,
-                                                         PARAM_END};
+#include "macros.h"
+#include "parse.h"
 
-    methods[0].name = METHOD_TRANSFER;
-    methods[0].parameters = transfer_params;
-    methods[1].name = METHOD_TRANSFER_FROM;
-    methods[1].parameters = transfer_from_params;
-    methods[2].name = METHOD_APPROVE;
-    methods[2].parameters = approve_params;
-    methods[3].name = METHOD_TRANSFER_V2;
-    methods[3].parameters = transfer_params;
-    methods[4].name = METHOD_TRANSFER_FROM_V2;
-    methods[4].parameters = transfer_from_params;
-    methods[5].name = METHOD_APPROVE_V2;
-    methods[5].parameters = approve_params;
-    methods[6].name = NULL;
-}
-
-void get_neovm_oep4_token_methods(tx_method_signature_t *methods) {
-    static const tx_parameter_type_e transfer_approve_params[] = {PARAM_AMOUNT,
-                                                                  PARAM_ADDR,
-                                                                  PARAM_ADDR,
-                                                                  PARAM_END};
-    static const tx_parameter_type_e transfer_from_params[] = {PARAM_AMOUNT,
-                                                               PARAM_ADDR,
-                                                               PARAM_ADDR,
-                                                               PARAM_ADDR,
-                                                               PARAM_END};
-    methods[0].name = METHOD_TRANSFER;
-    methods[0].parameters = transfer_approve_params;
-    methods[1].name = METHOD_TRANSFER_FROM;
-    methods[1].parameters = transfer_from_params;
-    methods[2].name = METHOD_APPROVE;
-    methods[2].parameters = transfer_approve_params;
-    methods[3].name = NULL;
-}
+#if defined(TEST)
+#define PIC(x) (x)
+#else
+#include "os_pic.h"
+#endif
 
-void get_wasmvm_oep4_token_methods(tx_method_signature_t *methods) {
-    static const tx_parameter_type_e transfer_approve_params[] = {PARAM_ADDR,
-                                                                  PARAM_ADDR,
-                                                                  PARAM_UINT128,
-                                                                  PARAM_END};
-    static const tx_parameter_type_e transfer_from_params[] = {PARAM_ADDR,
-                                                               PARAM_ADDR,
-                                                               PARAM_ADDR,
-                                                               PARAM_UINT128,
-                                                               PARAM_END};
+#define METHOD(name, id, params) {name, sizeof(name) - 1, id, parse_params_##params}
 
-    methods[0].name = METHOD_TRANSFER;
-    methods[0].parameters = transfer_approve_params;
-    methods[1].name = METHOD_TRANSFER_FROM;
-    methods[1].parameters = transfer_from_params;
-    methods[2].name = METHOD_APPROVE;
-    methods[2].parameters = transfer_approve_params;
-    methods[3].name = NULL;
-}
+// Method tables, sorted by (name_len, name)
+static const tx_method_signature_t native_token_methods[] = {
+    METHOD(METHOD_APPROVE, METHOD_ID_APPROVE, native_approve),
+    METHOD(METHOD_TRANSFER, METHOD_ID_TRANSFER, native_transfer),
+    METHOD(METHOD_APPROVE_V2, METHOD_ID_APPROVE_V2, native_approve),
+    METHOD(METHOD_TRANSFER_V2, METHOD_ID_TRANSFER_V2, native_transfer),
+    METHOD(METHOD_TRANSFER_FROM, METHOD_ID_TRANSFER_FROM, native_transfer_from),
+    METHOD(METHOD_TRANSFER_FROM_V2, METHOD_ID_TRANSFER_FROM_V2, native_transfer_from),
+};
 
-void get_native_governance_methods(tx_method_signature_t *methods) {
-    static const tx_parameter_type_e register_params[] =
-        {PARAM_PUBKEY, PARAM_ADDR, PARAM_AMOUNT, PARAM_ONTID, PARAM_AMOUNT, PARAM_END};
-    static const tx_parameter_type_e quit_params[] = {PARAM_PUBKEY, PARAM_ADDR, PARAM_END};
-    static const tx_parameter_type_e add_init_params[] = {PARAM_PUBKEY,
-                                                          PARAM_ADDR,
-                                                          PARAM_AMOUNT,
-                                                          PARAM_END};
-    static const tx_parameter_type_e reduce_init_params[] = {PARAM_PUBKEY,
-                                                             PARAM_ADDR,
-                                                             PARAM_AMOUNT,
-                                                             PARAM_END};
-    static const tx_parameter_type_e change_max_params[] = {PARAM_PUBKEY,
-                                                            PARAM_ADDR,
-                                                            PARAM_AMOUNT,
-                                                            PARAM_END};
-    static const tx_parameter_type_e set_fee_params[] = {PARAM_PUBKEY,
-                                                         PARAM_ADDR,
-                                                         PARAM_AMOUNT,
-                                                         PARAM_AMOUNT,
-                                                         PARAM_END};
-    static const tx_parameter_type_e auth_params[] = {PARAM_ADDR, PARAM_PK_AMOUNT_PAIRS, PARAM_END};
-    static const tx_parameter_type_e withdraw_params[] = {PARAM_ADDR,
-                                                          PARAM_PK_AMOUNT_PAIRS,
-                                                          PARAM_END};
-    static const tx_parameter_type_e withdraw_fee_params[] = {PARAM_ADDR, PARAM_END};
+static const tx_method_signature_t native_governance_methods[] = {
+    METHOD(METHOD_QUIT_NODE, METHOD_ID_QUIT_NODE, gov_quit),
+    METHOD(METHOD_WITHDRAW, METHOD_ID_WITHDRAW, gov_auth),
+    METHOD(METHOD_ADD_INIT_POS, METHOD_ID_ADD_INIT_POS, gov_pos),
+    METHOD(METHOD_WITHDRAW_FEE, METHOD_ID_WITHDRAW_FEE, gov_withdraw_fee),
+    METHOD(METHOD_REDUCE_INIT_POS, METHOD_ID_REDUCE_INIT_POS, gov_pos),
+    METHOD(METHOD_AUTHORIZE_FOR_PEER, METHOD_ID_AUTHORIZE_FOR_PEER, gov_auth),
+    METHOD(METHOD_SET_FEE_PERCENTAGE, METHOD_ID_SET_FEE_PERCENTAGE, gov_set_fee),
+    METHOD(METHOD_REGISTER_CANDIDATE, METHOD_ID_REGISTER_CANDIDATE, gov_register),
+    METHOD(METHOD_UNAUTHORIZE_FOR_PEER, METHOD_ID_UNAUTHORIZE_FOR_PEER, gov_auth),
+    METHOD(METHOD_CHANGE_MAX_AUTH, METHOD_ID_CHANGE_MAX_AUTH, gov_pos),
+};
 
-    methods[0].name = METHOD_REGISTER_CANDIDATE;
-    methods[0].parameters = register_params;
-    methods[1].name = METHOD_QUIT_NODE;
-    methods[1].parameters = quit_params;
-    methods[2].name = METHOD_ADD_INIT_POS;
-    methods[2].parameters = add_init_params;
-    methods[3].name = METHOD_REDUCE_INIT_POS;
-    methods[3].parameters = reduce_init_params;
-    methods[4].name = METHOD_CHANGE_MAX_AUTH;
-    methods[4].parameters = change_max_params;
-    methods[5].name = METHOD_SET_FEE_PERCENTAGE;
-    methods[5].parameters = set_fee_params;
-    methods[6].name = METHOD_AUTHORIZE_FOR_PEER;
-    methods[6].parameters = auth_params;
-    methods[7].name = METHOD_UNAUTHORIZE_FOR_PEER;
-    methods[7].parameters = auth_params;
-    methods[8].name = METHOD_WITHDRAW;
-    methods[8].parameters = withdraw_params;
-    methods[9].name = METHOD_WITHDRAW_FEE;
-    methods[9].parameters = withdraw_fee_params;
-    methods[10].name = NULL;
-}
+static const tx_method_signature_t neovm_oep4_token_methods[] = {
+    METHOD(METHOD_APPROVE, METHOD_ID_APPROVE, neovm_transfer_approve),
+    METHOD(METHOD_TRANSFER, METHOD_ID_TRANSFER, neovm_transfer_approve),
+    METHOD(METHOD_TRANSFER_FROM, METHOD_ID_TRANSFER_FROM, neovm_transfer_from),
+};
 
-void get_tx_payload(payload_t *storage) {
-    memcpy(storage[0].contract_addr, ONT_ADDR, ADDRESS_SCRIPT_HASH_LEN);
-    storage[0].token_decimals = ONT_DECIMALS;
-    storage[0].ticker = ONT_TICKER;
-    get_native_token_methods((tx_method_signature_t *) storage[0].methods);
+static const tx_method_signature_t wasmvm_oep4_token_methods[] = {
+    METHOD(METHOD_APPROVE, METHOD_ID_APPROVE, wasmvm_transfer_approve),
+    METHOD(METHOD_TRANSFER, METHOD_ID_TRANSFER, wasmvm_transfer_approve),
+    METHOD(METHOD_TRANSFER_FROM, METHOD_ID_TRANSFER_FROM, wasmvm_transfer_from),
+};
 
-    memcpy(storage[1].contract_addr, ONG_ADDR, ADDRESS_SCRIPT_HASH_LEN);
-    storage[1].token_decimals = ONG_DECIMALS;
-    storage[1].ticker = ONG_TICKER;  // it's the gas token
-    get_native_token_methods((tx_method_signature_t *) storage[1].methods);
+#define PAYLOAD(addr, type, decimals, ticker, methods) \
+    {(const uint8_t *) (addr), type, decimals, ARRAY_LENGTH(methods), ticker, methods}
 
-    memcpy(storage[2].contract_addr, GOV_ADDR, ADDRESS_SCRIPT_HASH_LEN);
-    // not the token decimals, it's the one of the token operated by this contract
-    storage[2].token_decimals = ONT_DECIMALS;
-    // not the token ticker, it's the one of the token operated by this contract
-    storage[2].ticker = ONT_TICKER;
-    get_native_governance_methods((tx_method_signature_t *) storage[2].methods);
+// Registered contracts, sorted by script hash
+const payload_t PREDEFINED_PAYLOADS[] = {
+    PAYLOAD(ONT_ADDR, NATIVE_CONTRACT, ONT_DECIMALS, ONT_TICKER, native_token_methods),
+    // it's the gas token
+    PAYLOAD(ONG_ADDR, NATIVE_CONTRACT, ONG_DECIMALS, ONG_TICKER, native_token_methods),
+    // not the token decimals and ticker, it's the ones of the token operated by this contract
+    PAYLOAD(GOV_ADDR, NATIVE_CONTRACT, ONT_DECIMALS, ONT_TICKER, native_governance_methods),
+    PAYLOAD(MBL_ADDR, NEOVM_CONTRACT, 8, "MBL", neovm_oep4_token_methods),
+    PAYLOAD(WING_ADDR, NEOVM_CONTRACT, 9, "WING", neovm_oep4_token_methods),
+    PAYLOAD(STONT_ADDR, WASMVM_CONTRACT, 9, "stONT", wasmvm_oep4_token_methods),
+};
 
-    memcpy(storage[3].contract_addr, WING_ADDR, ADDRESS_SCRIPT_HASH_LEN);
-    storage[3].token_decimals = 9;
-    storage[3].ticker = "WING";
-    get_neovm_oep4_token_methods((tx_method_signature_t *) storage[3].methods);
+const size_t PREDEFINED_PAYLOADS_NUM = ARRAY_LENGTH(PREDEFINED_PAYLOADS);
 
-    memcpy(storage[4].contract_addr, STONT_ADDR, ADDRESS_SCRIPT_HASH_LEN);
-    storage[4].token_decimals = 9;
-    storage[4].ticker = "stONT";
-    get_wasmvm_oep4_token_methods((tx_method_signature_t *) storage[4].methods);
+const payload_t *find_tx_payload(const uint8_t *contract_addr) {
+    size_t lo = 0;
+    size_t hi = ARRAY_LENGTH(PREDEFINED_PAYLOADS);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = memcmp(contract_addr,
+                         PIC(PREDEFINED_PAYLOADS[mid].contract_addr),
+                         ADDRESS_SCRIPT_HASH_LEN);
+        if (cmp == 0) {
+            return &PREDEFINED_PAYLOADS[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
 
-    memcpy(storage[5].contract_addr, MBL_ADDR, ADDRESS_SCRIPT_HASH_LEN);
-    storage[5].token_decimals = 8;
-    storage[5].ticker = "MBL";
-    get_neovm_oep4_token_methods((tx_method_signature_t *) storage[5].methods);
+const tx_method_signature_t *find_tx_method(const payload_t *payload,
+                                            const uint8_t *name,
+                                            size_t name_len) {
+    const tx_method_signature_t *methods = PIC(payload->methods);
+    size_t lo = 0;
+    size_t hi = payload->methods_num;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = (int) name_len - (int) methods[mid].name_len;
+        if (cmp == 0) {
+            cmp = memcmp(name, PIC(methods[mid].name), name_len);
+        }
+        if (cmp == 0) {
+            return &methods[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
 }
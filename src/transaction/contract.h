@@ -1,11 +1,11 @@
 #pragma once
 
+#include <stdbool.h>  // bool
+
+#include "buffer.h"
 #include "tx_types.h"
 #include "address.h"
 
-#define MAX_METHOD_NUM 11
-#define PREDEFINED_CONTRACT_NUM 6    //should be updated if there is new predefined items.
-
 #define ONG_TICKER "ONG"                     //native, gas token
 #define ONT_TICKER "ONT"                     //native, staking token
 #define ONG_DECIMALS 9                       // 18 for transferV2, transferFromV2, approveV2
@@ -39,34 +39,97 @@
 #define METHOD_WITHDRAW "withdraw"
 #define METHOD_WITHDRAW_FEE "withdrawFee"
 
+// Parameters of the registered methods: PARAMS(P) expands P(type) for each parameter, in order,
+// `type` being a tx_parameter_type_e without its PARAM_ prefix.
+#define NATIVE_TRANSFER_FROM_PARAMS(P)    P(ADDR) P(TRANSFER_STATE)
+#define NATIVE_APPROVE_PARAMS(P)          P(ADDR) P(ADDR) P(AMOUNT)
+#define NEOVM_TRANSFER_APPROVE_PARAMS(P)  P(AMOUNT) P(ADDR) P(ADDR)
+#define NEOVM_TRANSFER_FROM_PARAMS(P)     P(AMOUNT) P(ADDR) P(ADDR) P(ADDR)
+#define WASMVM_TRANSFER_APPROVE_PARAMS(P) P(ADDR) P(ADDR) P(UINT128)
+#define WASMVM_TRANSFER_FROM_PARAMS(P)    P(ADDR) P(ADDR) P(ADDR) P(UINT128)
+#define GOV_REGISTER_PARAMS(P)            P(PUBKEY) P(ADDR) P(AMOUNT) P(ONTID) P(AMOUNT)
+#define GOV_QUIT_PARAMS(P)                P(PUBKEY) P(ADDR)
+#define GOV_POS_PARAMS(P)                 P(PUBKEY) P(ADDR) P(AMOUNT)
+#define GOV_SET_FEE_PARAMS(P)             P(PUBKEY) P(ADDR) P(AMOUNT) P(AMOUNT)
+#define GOV_AUTH_PARAMS(P)                P(ADDR) P(PK_AMOUNT_PAIRS)
+#define GOV_WITHDRAW_FEE_PARAMS(P)        P(ADDR)
+
+// Signatures of the registered methods, X(vm, name, PARAMS) with `vm` one of NATIVE, NEOVM or
+// WASMVM. A straight-line parser `parse_params_<name>` is generated for each of them in parse.c.
+// The native transfer and transferV2 take a list of transfer states, their parser is written by
+// hand: parse_params_native_transfer.
+#define TX_METHOD_SIGNATURES(X)                                         \
+    X(NATIVE, native_transfer_from, NATIVE_TRANSFER_FROM_PARAMS)        \
+    X(NATIVE, native_approve, NATIVE_APPROVE_PARAMS)                    \
+    X(NEOVM, neovm_transfer_approve, NEOVM_TRANSFER_APPROVE_PARAMS)     \
+    X(NEOVM, neovm_transfer_from, NEOVM_TRANSFER_FROM_PARAMS)           \
+    X(WASMVM, wasmvm_transfer_approve, WASMVM_TRANSFER_APPROVE_PARAMS)  \
+    X(WASMVM, wasmvm_transfer_from, WASMVM_TRANSFER_FROM_PARAMS)        \
+    X(NATIVE, gov_register, GOV_REGISTER_PARAMS)                        \
+    X(NATIVE, gov_quit, GOV_QUIT_PARAMS)                                \
+    X(NATIVE, gov_pos, GOV_POS_PARAMS)                                  \
+    X(NATIVE, gov_set_fee, GOV_SET_FEE_PARAMS)                          \
+    X(NATIVE, gov_auth, GOV_AUTH_PARAMS)                                \
+    X(NATIVE, gov_withdraw_fee, GOV_WITHDRAW_FEE_PARAMS)
+
+/**
+ * Parser of the arguments of a method, moving the buffer past them.
+ */
+typedef bool (*tx_params_parser_t)(buffer_t *buf, transaction_t *tx);
+
 /**
  * Structure for transaction method signature.
  */
 typedef struct {
     const char *name;
-    const tx_parameter_type_e *parameters;
+    uint8_t name_len;
+    tx_method_id_e id;
+    tx_params_parser_t parse_params;
 } tx_method_signature_t;
 
 /**
- * Structure for transaction payload.
+ * Structure for transaction payload, namely a registered contract and its methods.
  */
 typedef struct {
+    const uint8_t *contract_addr;
+    uint8_t contract_type;  // tx_contract_type_e, the parsers of the methods are specific to it
     uint8_t token_decimals;
+    uint8_t methods_num;
     const char *ticker;
-    uint8_t contract_addr[ADDRESS_SCRIPT_HASH_LEN];
-    tx_method_signature_t methods[MAX_METHOD_NUM];
+    const tx_method_signature_t *methods;  // sorted by (name_len, name)
 } payload_t;
 
+/**
+ * The registered contracts, sorted by script hash.
+ * Add new contracts in `contract.c`, keeping the order.
+ */
+extern const payload_t PREDEFINED_PAYLOADS[];
+extern const size_t PREDEFINED_PAYLOADS_NUM;
 
+/**
+ * Look up a registered contract by binary search.
+ *
+ * @param[in] contract_addr
+ *   Script hash of the contract, ADDRESS_SCRIPT_HASH_LEN bytes.
+ *
+ * @return pointer to the registered contract, NULL if not found.
+ *
+ */
+const payload_t *find_tx_payload(const uint8_t *contract_addr);
 
 /**
- * Add the predefined contracts and their methods in this function
- * Don't forget to modify the `PREDEFINED_CONTRACT_NUM` if you add a new contract
+ * Look up a method of a registered contract by binary search.
  *
- * @param[out] storage
- *   Pointer to the pre-defined contracts and methods array.
+ * @param[in] payload
+ *   Pointer to the registered contract.
+ * @param[in] name
+ *   Pointer to the method name.
+ * @param[in] name_len
+ *   Length of the method name.
  *
- * @return none.
+ * @return pointer to the method signature, NULL if not found.
  *
  */
-void get_tx_payload(payload_t *storage);
\ No newline at end of file
+const tx_method_signature_t *find_tx_method(const payload_t *payload,
+                                            const uint8_t *name,
+                                            size_t name_len);
@@ -70,6 +70,8 @@ NEOVM contract
 WASM contract
 | Contract-wo-Length | Remaining-Length |Method-w-Length|    Params   |
 |    --20 bytes--    |   --any bytes--  |--any bytes--  |--any bytes--|
+The Remaining-Length and the length of the method name are varuints, and the params are
+serialized as read by Ontology's ZeroCopySource, see `wasm.h`.
 
 1. The parameters of the Native Token（ONG/ONT）'s `transfer` and `TransferV2` functions consist of
 multiple `transferstate` structures, followed by the count of `transferstate` structures and a
@@ -100,9 +102,14 @@ amount is 1.
 
 When the value N of the first byte of the amount is less than or equal to 16, it means the next N
 bytes are interpreted as a uint64_t integer in little-endian order as the value of the amount.
+The same bytes may also be pushed with PUSHDATA1, PUSHDATA2 or PUSHDATA4.
 
 Other cases are considered invalid bytecode.
 
+The NeoVM instructions are decoded by `neovm.c`: addresses, public keys and method names are
+pushed bytes as well, and the fixed sequences such as `6a7cc8` are matched instruction by
+instruction.
+
 In WASM contracts, the amount is 16 bytes, which is parsed as a uint128_t in little-endian order.
 Similarly, there is no prefix indicating the length.
 
@@ -118,6 +125,8 @@ Similarly, there is no prefix indicating the length.
 #include "utils.h"
 #include "types.h"
 #include "parse.h"
+#include "neovm.h"
+#include "wasm.h"
 #include "contract.h"
 #include "address.h"
 
@@ -128,6 +137,12 @@ Similarly, there is no prefix indicating the length.
 #include "ledger_assert.h"
 #endif
 
+#if defined(TEST)
+#define PIC(x) (x)
+#else
+#include "os_pic.h"
+#endif
+
 // Deserialize and check the header of the transaction (the first 42 bytes of the transaction)
 // The parameters and outputs of this function are same as the `transaction_deserialize` function.
 static parser_status_e transaction_deserialize_header(buffer_t *buf, transaction_t *tx) {
@@ -164,6 +179,11 @@ static parser_status_e transaction_deserialize_header(buffer_t *buf, transaction
         return PARSING_BYTECODE_WRONG;
     }
 
+    tx->raw = buf->ptr;
+    memset(&tx->method.group, 0, sizeof(tx->method.group));
+    memset(&tx->method.transfer_run, 0, sizeof(tx->method.transfer_run));
+    memset(&tx->method.pk_run, 0, sizeof(tx->method.pk_run));
+
     // payer
     tx->header.payer = (uint8_t *) (buf->ptr + buf->offset);
     if (!buffer_seek_cur(buf, ADDRESS_SCRIPT_HASH_LEN)) {
@@ -174,82 +194,199 @@ static parser_status_e transaction_deserialize_header(buffer_t *buf, transaction
 }
 
 // Deserialize the payload size of the transaction, and check if the payload size is valid.
-// The parameters and outputs of this function are same as the `transaction_deserialize` function.
-static parser_status_e transaction_deserialize_payload_size(buffer_t *buf, transaction_t *tx) {
+// On success, the payload bounds are recorded in `parser`.
+// Returns PARSING_NEED_MORE if the whole payload size has not been received yet.
+static parser_status_e transaction_deserialize_payload_size(buffer_t *buf, tx_parser_t *parser) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
-    LEDGER_ASSERT(tx != NULL, "NULL tx");
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
 
     uint8_t first_byte = 0;
-    size_t payload_size = 0;
-    if (!buffer_read_u8(buf, &first_byte) || first_byte == 0) {
+    uint64_t payload_size = 0;
+    if (!buffer_can_read(buf, 1)) {
+        return PARSING_NEED_MORE;
+    }
+    first_byte = buf->ptr[buf->offset];
+    if (first_byte == 0) {
         return PARSING_BYTECODE_WRONG;
     }
+    if (!buffer_read_varint(buf, &payload_size)) {
+        return PARSING_NEED_MORE;
+    }
 
-    switch (first_byte) {
-        case 0xfd: {
-            uint16_t payload_size_16 = 0;
-            if (!buffer_read_u16(buf, &payload_size_16, LE)) {
-                return PARSING_BYTECODE_WRONG;
-            }
-            payload_size = payload_size_16;
-            break;
+    if (payload_size > MAX_TRANSACTION_LEN - buf->offset - ARRAY_LENGTH(OPCODE_END)) {
+        return PARSING_LENGTH_WRONG;
+    }
+    parser->payload_begin = buf->offset;
+    parser->payload_end = buf->offset + (size_t) payload_size;
+
+    return PARSING_OK;
+}
+
+// Longest encodings of the elements of the repeated groups, with PUSHDATA4 pushes: a transfer
+// state is 00c66b, two addresses and an amount of 16 bytes each followed by 6a7cc8, then 6c
+#define PUSH_MAX_LEN(n) (1 + 4 + (n))
+#define TRANSFER_STATE_MAX_LEN                                                        \
+    (ARRAY_LENGTH(OPCODE_ST_BEGIN) + 2 * (PUSH_MAX_LEN(ADDRESS_SCRIPT_HASH_LEN) +     \
+                                          ARRAY_LENGTH(OPCODE_PARAM_END)) +           \
+     PUSH_MAX_LEN(2 * sizeof(uint64_t)) + ARRAY_LENGTH(OPCODE_PARAM_ST_END))
+#define NATIVE_PK_MAX_LEN (PUSH_MAX_LEN(2 * COMPRESSED_KEY_LEN) + ARRAY_LENGTH(OPCODE_PARAM_END))
+
+// Validate the group element which may start at the offset of the buffer and extend `run` with
+// it. The method is not known yet: an element which does not validate is only not part of a run.
+// Returns PARSING_NEED_MORE if the element may not have been fully received, that is up to
+// `max_len` bytes or the end of the payload.
+static parser_status_e transaction_speculate_element(const buffer_t *buf,
+                                                     const tx_parser_t *parser,
+                                                     size_t max_len,
+                                                     bool (*skip)(buffer_t *buf),
+                                                     tx_group_run_t *run) {
+    size_t start = buf->offset;
+    size_t end = parser->payload_end - start > max_len ? start + max_len : parser->payload_end;
+    buffer_t element = {.ptr = buf->ptr,
+                        .size = buf->size < end ? buf->size : end,
+                        .offset = start};
+    if (!skip(&element)) {
+        return buf->size < end ? PARSING_NEED_MORE : PARSING_OK;
+    }
+
+    if (run->count == 0 || run->end != start) {
+        run->offset = (uint16_t) start;
+        run->count = 0;
+    }
+    run->end = (uint16_t) element.offset;
+    run->count++;
+    return PARSING_OK;
+}
+
+// Validate the transfer states and the public keys of the native arguments as they arrive, so
+// that the last chunk only has to step over them once the method is known.
+// Transfer states can only be the arguments of a transfer, from the start of the payload.
+static parser_status_e transaction_speculate_groups(const buffer_t *buf,
+                                                    const tx_parser_t *parser,
+                                                    const neovm_token_t *token,
+                                                    transaction_t *tx) {
+    tx_group_run_t *transfers = &tx->method.transfer_run;
+    if (buf->offset == transfers->end && token->opcode == OPCODE_ST_BEGIN[0] &&
+        transfers->count < TRANSFER_STATES_MAX_NUM) {
+        return transaction_speculate_element(buf,
+                                             parser,
+                                             TRANSFER_STATE_MAX_LEN,
+                                             parse_skip_transfer_state,
+                                             transfers);
+    }
+    if (token->type == NEOVM_TOKEN_PUSH_BYTES && token->data_len == 2 * COMPRESSED_KEY_LEN &&
+        tx->method.pk_run.count < UINT16_MAX) {
+        return transaction_speculate_element(buf,
+                                             parser,
+                                             NATIVE_PK_MAX_LEN,
+                                             parse_skip_native_pk,
+                                             &tx->method.pk_run);
+    }
+    return PARSING_OK;
+}
+
+// Walk the NeoVM payload code instruction by instruction as it arrives.
+// Every instruction must end inside the payload. If one does not, the code cannot match any
+// registered method and `opaque_code` is set: the rest of the payload is only waited for.
+// Returns PARSING_NEED_MORE while the payload has not been fully received.
+static parser_status_e transaction_deserialize_code(buffer_t *buf,
+                                                    tx_parser_t *parser,
+                                                    transaction_t *tx) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+
+    neovm_token_t token;
+    while (!parser->opaque_code && buf->offset < parser->payload_end) {
+        if (!neovm_decode_token(buf, &token) ||
+            transaction_speculate_groups(buf, parser, &token, tx) == PARSING_NEED_MORE) {
+            return PARSING_NEED_MORE;
         }
-        case 0xfe: {
-            uint32_t payload_size_32 = 0;
-            if (!buffer_read_u32(buf, &payload_size_32, LE)) {
-                return PARSING_BYTECODE_WRONG;
-            }
-            payload_size = payload_size_32;
+        if (token.len > parser->payload_end - buf->offset) {
+            parser->opaque_code = true;
             break;
         }
-        case 0xff: {
-            uint64_t payload_size_64 = 0;
-            if (!buffer_read_u64(buf, &payload_size_64, LE)) {
-                return PARSING_BYTECODE_WRONG;
-            }
-            payload_size = payload_size_64;
-            break;
+        if (!buffer_can_read(buf, token.len)) {
+            return PARSING_NEED_MORE;
         }
-        default:
-            payload_size = first_byte;
-            break;
-    }
 
-    bool is_valid = (buf->offset + payload_size + ARRAY_LENGTH(OPCODE_END) != buf->size);
+        // Remember where the invocation is: the method name is pushed right before APPCALL,
+        // and right before the contract address and the PUSH0 preceding SYSCALL
+        size_t method = NEOVM_RECENT_NUM;
+        if (token.type == NEOVM_TOKEN_APPCALL) {
+            method = 0;
+        } else if (token.type == NEOVM_TOKEN_SYSCALL) {
+            method = 2;
+        }
+        if (method != NEOVM_RECENT_NUM) {
+            parser->call_offset = buf->offset;
+            parser->method_offset = parser->recent[method];
+            memcpy(parser->method_prev,
+                   &parser->recent[method + 1],
+                   sizeof(parser->method_prev));
+        }
+        memmove(&parser->recent[1],
+                &parser->recent[0],
+                sizeof(parser->recent[0]) * (NEOVM_RECENT_NUM - 1));
+        parser->recent[0] = buf->offset;
 
-    return is_valid ? PARSING_LENGTH_WRONG : PARSING_OK;
+        buffer_seek_cur(buf, token.len);
+        parser->offset = buf->offset;
+    }
+    return buf->size < parser->payload_end ? PARSING_NEED_MORE : PARSING_OK;
 }
 
 // Deserialize the contract of the transaction and get the contract type and address.
-// It also check the following fiexd bytes of the native and neovm contracts.
+// For native and neovm contracts, the invocation is the last instruction walked: APPCALL followed
+// by the contract address for neovm, or the contract address, PUSH0 and SYSCALL
+// "Ontology.Native.Invoke" for native. The fixed bytes are checked from there.
+// Code that could not be walked is matched against the fixed trailing bytes instead.
 // The parameters and outputs of this function are same as the `transaction_deserialize` function.
-static parser_status_e transaction_deserialize_contract(buffer_t *buf, transaction_t *tx) {
+static parser_status_e transaction_deserialize_contract(buffer_t *buf,
+                                                        const tx_parser_t *parser,
+                                                        transaction_t *tx) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
     LEDGER_ASSERT(tx != NULL, "NULL tx");
 
     size_t os = buf->offset;
+    neovm_token_t token;
     switch (tx->header.tx_type) {
         case 0xd1: {
-            if(!buffer_can_read(buf, ARRAY_LENGTH(OPCODE_END) + ADDRESS_SCRIPT_HASH_LEN + 1)) {
+            size_t call = parser->call_offset;
+            if (parser->opaque_code) {
+                if (!buffer_can_read(buf, ARRAY_LENGTH(OPCODE_END) + ADDRESS_SCRIPT_HASH_LEN + 1)) {
+                    return PARSING_BYTECODE_WRONG;
+                }
+                call = buf->size - ARRAY_LENGTH(OPCODE_END) - ADDRESS_SCRIPT_HASH_LEN - 1;
+                if (buf->ptr[call] != OPCODE_APPCALL[0]) {
+                    call = buf->size - NATIVE_CONTRACT_CONSTANT_LENGTH + ADDRESS_SCRIPT_HASH_LEN +
+                           ARRAY_LENGTH(OPCODE_SYSCALL);
+                }
+            }
+            if (call < parser->payload_begin || call >= parser->payload_end) {
                 return PARSING_BYTECODE_WRONG;
             }
-            if (buf->ptr[buf->size - ARRAY_LENGTH(OPCODE_END) - ADDRESS_SCRIPT_HASH_LEN - 1] !=
-                OPCODE_APPCALL[0]) {  //'n' for the native contract
+
+            if (buf->ptr[call] != OPCODE_APPCALL[0]) {  // SYSCALL for the native contract
                 tx->contract.type = NATIVE_CONTRACT;
-                if (!buffer_can_read(buf, NATIVE_CONTRACT_CONSTANT_LENGTH) ||
-                    !buffer_seek_set(buf, buf->size - NATIVE_CONTRACT_CONSTANT_LENGTH) ||
+                size_t contract = call - ARRAY_LENGTH(OPCODE_SYSCALL) - ADDRESS_SCRIPT_HASH_LEN;
+                if (call < parser->payload_begin + ARRAY_LENGTH(OPCODE_SYSCALL) +
+                               ADDRESS_SCRIPT_HASH_LEN ||
+                    !buffer_seek_set(buf, contract) ||
                     !parse_address(buf, true, &(tx->contract.addr)) ||
-                    !parse_check_constant(buf, OPCODE_SYSCALL, ARRAY_LENGTH(OPCODE_SYSCALL)) ||
-                    !parse_check_constant(buf, NATIVE_INVOKE, ARRAY_LENGTH(NATIVE_INVOKE)) ||
+                    !neovm_read_opcodes(buf, OPCODE_SYSCALL, 1) ||
+                    !neovm_read_token(buf, &token) || token.type != NEOVM_TOKEN_SYSCALL ||
+                    token.data_len != ARRAY_LENGTH(NATIVE_INVOKE) - 1 ||
+                    memcmp(buf->ptr + token.data_offset, NATIVE_INVOKE + 1, token.data_len) != 0 ||
                     !parse_check_constant(buf, OPCODE_END, ARRAY_LENGTH(OPCODE_END)) ||
                     buf->offset != buf->size || !buffer_seek_set(buf, os)) {
                     return PARSING_BYTECODE_WRONG;
                 }
             } else {  // 0x67 for the neovm contract
                 tx->contract.type = NEOVM_CONTRACT;
-                if (!buffer_can_read(buf, NEOVM_CONTRACT_CONSTANT_LENGTH) ||
-                    !buffer_seek_set(buf, buf->size - NEOVM_CONTRACT_CONSTANT_LENGTH) ||
-                    !parse_check_constant(buf, OPCODE_APPCALL, ARRAY_LENGTH(OPCODE_APPCALL)) ||
+                if (!buffer_seek_set(buf, call) || !neovm_read_token(buf, &token) ||
+                    token.type != NEOVM_TOKEN_APPCALL || !buffer_seek_set(buf, token.data_offset) ||
                     !parse_address(buf, false, &(tx->contract.addr)) ||
                     !parse_check_constant(buf, OPCODE_END, ARRAY_LENGTH(OPCODE_END)) ||
                     buf->offset != buf->size || !buffer_seek_set(buf, os)) {
@@ -260,7 +397,7 @@ static parser_status_e transaction_deserialize_contract(buffer_t *buf, transacti
         }
         case 0xd2:
             tx->contract.type = WASMVM_CONTRACT;
-            if (!parse_address(buf, false, &(tx->contract.addr))) {
+            if (!wasm_read_address(buf, &(tx->contract.addr))) {
                 return PARSING_BYTECODE_WRONG;
             }
             break;
@@ -271,30 +408,41 @@ static parser_status_e transaction_deserialize_contract(buffer_t *buf, transacti
 }
 
 // Deserialize the method of the transaction and get the method name.
-// For native contracts and neovm contracts, since the trailing bytes are fixed, parse backwards
-// until encountering either 0xc1 (for NEOVM contract transactions and native token
-// transfer/transferV2 transactions) or 0x6a7cc86c (for other native transactions). The method name
-// follows these bytes.
+// For native contracts and neovm contracts, the method name push has been located while walking
+// the payload code. It must end where the invocation starts, and follow either 0xc1 (for NEOVM
+// contract transactions and native token transfer/transferV2 transactions) or 0x6a7cc86c (for
+// other native transactions).
 // For wasm contracts, the method name is the first parameter in the payload section.
 // The parameters and outputs of this function are same as the `transaction_deserialize` function.
-static parser_status_e transaction_deserialize_method(buffer_t *buf, transaction_t *tx) {
+static parser_status_e transaction_deserialize_method(buffer_t *buf,
+                                                      const tx_parser_t *parser,
+                                                      transaction_t *tx) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
     LEDGER_ASSERT(tx != NULL, "NULL tx");
 
     size_t sBegin = buf->offset;
     size_t sEnd = 0;
     switch (tx->contract.type) {
         case NATIVE_CONTRACT:
-            sEnd = buf->size - NATIVE_CONTRACT_CONSTANT_LENGTH;
+            sEnd = parser->call_offset - ARRAY_LENGTH(OPCODE_SYSCALL) - ADDRESS_SCRIPT_HASH_LEN;
             break;
         case NEOVM_CONTRACT:
-            sEnd = buf->size - NEOVM_CONTRACT_CONSTANT_LENGTH;
+            sEnd = parser->call_offset;
             break;
         case WASMVM_CONTRACT: {
-            uint8_t remaining_size = 0;
-            if (!buffer_read_u8(buf, &remaining_size) || remaining_size == 0 ||
-                remaining_size != buf->size - buf->offset - ARRAY_LENGTH(OPCODE_END) ||
-                !parse_method_name(buf, &(tx->method.name))) {
+            uint64_t remaining_size = 0;
+            if (!wasm_read_varuint(buf, &remaining_size) || remaining_size == 0 ||
+                remaining_size != buf->size - buf->offset - ARRAY_LENGTH(OPCODE_END)) {
+                return PARSING_BYTECODE_WRONG;
+            }
+            // A method name too long to be registered can only be blind signed
+            buffer_t name = *buf;
+            uint64_t name_len = 0;
+            if (wasm_read_varuint(&name, &name_len) && name_len > UINT8_MAX) {
+                return PARSING_TX_NOT_DEFINED;
+            }
+            if (!parse_method_name(buf, false, &(tx->method.name))) {
                 return PARSING_BYTECODE_WRONG;
             }
             return PARSING_OK;
@@ -303,57 +451,29 @@ static parser_status_e transaction_deserialize_method(buffer_t *buf, transaction
             return PARSING_BYTECODE_WRONG;
     }
 
-    // Validate sEnd to prevent underflow
-    if (sEnd < sBegin || sEnd > buf->size || sEnd < sBegin + (ARRAY_LENGTH(OPCODE_PACK) - 2)) {
+    size_t cur = parser->method_offset;
+    if (cur < sBegin || !buffer_seek_set(buf, cur) ||
+        !parse_method_name(buf, true, &(tx->method.name)) || buf->offset != sEnd) {
         return PARSING_BYTECODE_WRONG;
     }
 
-    size_t method_intent_length = 0;
-    size_t cur = 0;
-    for (size_t i = sEnd - (ARRAY_LENGTH(OPCODE_PACK) - 2); i >= sBegin; i--) {
-        if (tx->contract.type == NATIVE_CONTRACT &&
-            i <= sEnd - (ARRAY_LENGTH(OPCODE_PARAM_ST_END) - 2) &&
-            memcmp(buf->ptr + i, OPCODE_PARAM_ST_END, ARRAY_LENGTH(OPCODE_PARAM_ST_END)) == 0) {
-            cur = i + ARRAY_LENGTH(OPCODE_PARAM_ST_END);
-            break;
-        }
-        if (memcmp(buf->ptr + i, OPCODE_PACK, ARRAY_LENGTH(OPCODE_PACK)) == 0) {
-            cur = i + ARRAY_LENGTH(OPCODE_PACK);
-            break;
-        }
-    }
-    method_intent_length = sEnd - 1 - cur;
-
-    if (!buffer_seek_set(buf, cur) || method_intent_length == 0 ||
-        !parse_method_name(buf, &(tx->method.name)) || tx->method.name.len != method_intent_length ||
-        !buffer_seek_set(buf, sBegin)) {
+    // The instructions before the method name push were walked, they are read again from there
+    const size_t *prev = parser->method_prev;
+    bool after_pack = prev[0] >= sBegin && buffer_seek_set(buf, prev[0]) &&
+                      neovm_read_opcodes(buf, OPCODE_PACK, ARRAY_LENGTH(OPCODE_PACK)) &&
+                      buf->offset == cur;
+    bool after_st_end =
+        tx->contract.type == NATIVE_CONTRACT &&
+        prev[ARRAY_LENGTH(OPCODE_PARAM_ST_END) - 1] >= sBegin &&
+        buffer_seek_set(buf, prev[ARRAY_LENGTH(OPCODE_PARAM_ST_END) - 1]) &&
+        neovm_read_opcodes(buf, OPCODE_PARAM_ST_END, ARRAY_LENGTH(OPCODE_PARAM_ST_END)) &&
+        buf->offset == cur;
+    if ((!after_pack && !after_st_end) || !buffer_seek_set(buf, sBegin)) {
         return PARSING_BYTECODE_WRONG;
     }
     return PARSING_OK;
 }
 
-// Deserialize the parameters of the native token's transfer and transferV2 functions.
-// Called by `transaction_deserialize_params` function.
-// The parameters and outputs of this function are same as the `transaction_deserialize` function.
-static parser_status_e native_transfer_deserialize_params(buffer_t *buf, transaction_t *tx) {
-    LEDGER_ASSERT(buf != NULL, "NULL buf");
-    LEDGER_ASSERT(tx != NULL, "NULL tx");
-
-    size_t num = 0;
-    size_t cur = 0;
-    while (buf->ptr[buf->offset] == OPCODE_ST_BEGIN[0]) {
-        if (!parse_trasfer_state(buf, &(tx->method.parameters[cur]), &cur)) {
-            return PARSING_BYTECODE_WRONG;
-        }
-        num++;
-    }
-
-    return parse_check_amount(buf, num) &&
-                   parse_check_constant(buf, OPCODE_PACK, ARRAY_LENGTH(OPCODE_PACK))
-               ? PARSING_OK
-               : PARSING_BYTECODE_WRONG;
-}
-
 // Deserialize the parameters of the transaction.
 // Besides getting the parameters, also set the token ticker and token decimals.
 // The original decimals of ONT and ONG are 0 and 9, respectively.
@@ -366,74 +486,59 @@ static parser_status_e transaction_deserialize_params(buffer_t *buf, transaction
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(tx != NULL, "NULL tx");
 
+    // Resolve the contract and method once, everything after switches on `tx->method.id`
+    const uint8_t *contract_addr = param_data(tx->raw, &tx->contract.addr);
+    const payload_t *payload = find_tx_payload(contract_addr);
+    if (payload != NULL && payload->contract_type != tx->contract.type) {
+        payload = NULL;  // not the interface the methods were registered for
+    }
+    const tx_method_signature_t *method =
+        payload != NULL
+            ? find_tx_method(payload, param_data(tx->raw, &tx->method.name), tx->method.name.len)
+            : NULL;
+    tx->method.id = method != NULL ? method->id : METHOD_ID_UNKNOWN;
+
     if (tx->contract.type == NATIVE_CONTRACT) {
         tx->contract.token_decimals = ONT_DECIMALS;
-        bool is_ont = memcmp(tx->contract.addr.data, ONT_ADDR, ADDRESS_SCRIPT_HASH_LEN) == 0;
-        bool is_ong = memcmp(tx->contract.addr.data, ONG_ADDR, ADDRESS_SCRIPT_HASH_LEN) == 0;
+        bool is_ont = memcmp(contract_addr, ONT_ADDR, ADDRESS_SCRIPT_HASH_LEN) == 0;
+        bool is_ong = memcmp(contract_addr, ONG_ADDR, ADDRESS_SCRIPT_HASH_LEN) == 0;
         if (is_ont || is_ong) {
-            bool is_transfer = methodcmp(&tx->method.name, METHOD_TRANSFER);
-            bool is_transfer_v2 = methodcmp(&tx->method.name, METHOD_TRANSFER_V2);
-            bool is_transfer_from_v2 = methodcmp(&tx->method.name, METHOD_TRANSFER_FROM_V2);
-            bool is_approve_v2 = methodcmp(&tx->method.name, METHOD_APPROVE_V2);
-
             tx->contract.token_decimals = is_ong ? ONG_DECIMALS : ONT_DECIMALS;
-            if (is_transfer_v2 || is_transfer_from_v2 || is_approve_v2) {
+            tx_method_id_e id = tx->method.id;
+            if (id == METHOD_ID_TRANSFER_V2 || id == METHOD_ID_TRANSFER_FROM_V2 ||
+                id == METHOD_ID_APPROVE_V2) {
                 tx->contract.token_decimals += 9;
             }
 
-            if (is_transfer || is_transfer_v2) {
+            if (id == METHOD_ID_TRANSFER || id == METHOD_ID_TRANSFER_V2) {
                 tx->contract.ticker = is_ont ? ONT_TICKER : ONG_TICKER;
-                return native_transfer_deserialize_params(buf, tx);
+                tx_params_parser_t parse_params = (tx_params_parser_t) PIC(method->parse_params);
+                return parse_params(buf, tx) ? PARSING_OK : PARSING_BYTECODE_WRONG;
             }
         }
 
-        if (!parse_check_constant(buf, OPCODE_ST_BEGIN, ARRAY_LENGTH(OPCODE_ST_BEGIN))) {
+        if (!neovm_read_opcodes(buf, OPCODE_ST_BEGIN, ARRAY_LENGTH(OPCODE_ST_BEGIN))) {
             return PARSING_BYTECODE_WRONG;
         }
     }
 
-    payload_t payload[PREDEFINED_CONTRACT_NUM];
-    get_tx_payload(payload);
-
-    //count the number of parameters
-    //it is only used to check when the transaction is a neovm contract transaction
-    //It is NOT right to use it to get the number of parameters for other types of transactions.
-    //The parameters of a neovm contract transaction are simple types, not composite types
-    size_t params_num = 0; 
-
-    for (size_t i = 0; i < PREDEFINED_CONTRACT_NUM; i++) {
-        if (memcmp(tx->contract.addr.data, payload[i].contract_addr, ADDRESS_SCRIPT_HASH_LEN) == 0) {
-            tx->contract.ticker = payload[i].ticker;
-            if (tx->contract.type != NATIVE_CONTRACT) {
-                tx->contract.token_decimals = payload[i].token_decimals;
-            }
-            const tx_method_signature_t *methods = payload[i].methods;
-            while (methods->name != NULL) {
-                if (methodcmp(&tx->method.name, methods->name)) {
-                    if (!parse_method_params(buf, tx, methods->parameters, &params_num)) {
-                        return PARSING_BYTECODE_WRONG;
-                    }
-                    break;
-                }
-                ++methods;
-            }
-            if (methods->name == NULL) {
-                return PARSING_TX_NOT_DEFINED;  // blind signed transaction
-            }
-            break;
-        }
-        if (i == PREDEFINED_CONTRACT_NUM - 1) {
-            return PARSING_TX_NOT_DEFINED;  // blind signed transaction
-        }
+    if (payload == NULL) {
+        return PARSING_TX_NOT_DEFINED;  // blind signed transaction
     }
-
-    if (tx->contract.type == NATIVE_CONTRACT &&
-        !parse_check_constant(buf, OPCODE_ST_END, ARRAY_LENGTH(OPCODE_ST_END))) {
+    tx->contract.ticker = PIC(payload->ticker);
+    if (tx->contract.type != NATIVE_CONTRACT) {
+        tx->contract.token_decimals = payload->token_decimals;
+    }
+    if (method == NULL) {
+        return PARSING_TX_NOT_DEFINED;  // blind signed transaction
+    }
+    tx_params_parser_t parse_params = (tx_params_parser_t) PIC(method->parse_params);
+    if (!parse_params(buf, tx)) {
         return PARSING_BYTECODE_WRONG;
     }
-    if (tx->contract.type == NEOVM_CONTRACT &&
-        (!parse_check_amount(buf, params_num) ||
-         !parse_check_constant(buf, OPCODE_PACK, ARRAY_LENGTH(OPCODE_PACK)))) {
+
+    if (tx->contract.type == NATIVE_CONTRACT &&
+        !neovm_read_opcodes(buf, OPCODE_ST_END, ARRAY_LENGTH(OPCODE_ST_END))) {
         return PARSING_BYTECODE_WRONG;
     }
     if (tx->contract.type == WASMVM_CONTRACT &&
@@ -444,28 +549,33 @@ static parser_status_e transaction_deserialize_params(buffer_t *buf, transaction
     return PARSING_OK;
 }
 
-// Deserialize the transaction.
-// Parse the transaction header, payload size, contract, method, and parameters sequentially.
-parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
+// Resolve the parts of the transaction that depend on the invocation at the end of the payload
+// once it has been fully received: the contract and method located while walking the code, then
+// the parameters from the start of the payload, stepping over the group elements already
+// validated while it arrived.
+static parser_status_e transaction_deserialize_tail(buffer_t *buf,
+                                                    const tx_parser_t *parser,
+                                                    transaction_t *tx) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
     LEDGER_ASSERT(tx != NULL, "NULL tx");
 
-    parser_status_e status = transaction_deserialize_header(buf, tx);
-    if (status != PARSING_OK) {
-        return status;
+    if (buf->size != parser->payload_end + ARRAY_LENGTH(OPCODE_END) ||
+        !buffer_seek_set(buf, parser->payload_begin)) {
+        return PARSING_LENGTH_WRONG;
     }
 
-    status = transaction_deserialize_payload_size(buf, tx);
+    parser_status_e status = transaction_deserialize_contract(buf, parser, tx);
     if (status != PARSING_OK) {
         return status;
     }
 
-    status = transaction_deserialize_contract(buf, tx);
-    if (status != PARSING_OK) {
-        return status;
+    // An invocation whose arguments could not be walked cannot match a registered method
+    if (parser->opaque_code) {
+        return PARSING_TX_NOT_DEFINED;
     }
 
-    status = transaction_deserialize_method(buf, tx);
+    status = transaction_deserialize_method(buf, parser, tx);
     if (status != PARSING_OK) {
         return status;
     }
@@ -492,3 +602,110 @@ parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
 
     return (buf->offset + len == buf->size) ? PARSING_OK : PARSING_LENGTH_WRONG;
 }
+
+// Run the stage the parser is in over the bytes received so far.
+// Returns PARSING_OK when the stage is complete and the parser moved on to the next one.
+static parser_status_e transaction_parser_step(tx_parser_t *parser,
+                                               buffer_t *buf,
+                                               bool last,
+                                               transaction_t *tx) {
+    parser_status_e status = PARSING_OK;
+    buf->offset = parser->offset;
+
+    switch (parser->stage) {
+        case TX_STAGE_HEADER:
+            if (!buffer_can_read(buf, TX_HEADER_LEN)) {
+                return PARSING_NEED_MORE;
+            }
+            status = transaction_deserialize_header(buf, tx);
+            if (status == PARSING_OK && tx->header.tx_type != 0xd1 &&
+                tx->header.tx_type != 0xd2) {
+                status = PARSING_BYTECODE_WRONG;
+            }
+            if (status == PARSING_OK) {
+                parser->offset = buf->offset;
+                parser->stage = TX_STAGE_PAYLOAD_SIZE;
+            }
+            return status;
+        case TX_STAGE_PAYLOAD_SIZE:
+            status = transaction_deserialize_payload_size(buf, parser);
+            if (status == PARSING_OK) {
+                parser->offset = buf->offset;
+                parser->stage = TX_STAGE_PAYLOAD;
+                tx->method.transfer_run.offset = (uint16_t) parser->payload_begin;
+                tx->method.transfer_run.end = (uint16_t) parser->payload_begin;
+            }
+            return status;
+        case TX_STAGE_PAYLOAD:
+            if (tx->header.tx_type == 0xd1) {
+                status = transaction_deserialize_code(buf, parser, tx);
+            } else if (buf->size < parser->payload_end) {  // wasm payload, checked in the tail
+                status = PARSING_NEED_MORE;
+            }
+            if (status == PARSING_OK) {
+                parser->offset = parser->payload_end;
+                parser->stage = TX_STAGE_TAIL;
+            }
+            return status;
+        case TX_STAGE_TAIL:
+            if (!last) {
+                return PARSING_NEED_MORE;
+            }
+            status = transaction_deserialize_tail(buf, parser, tx);
+            if (status == PARSING_OK) {
+                parser->offset = buf->size;
+                parser->stage = TX_STAGE_DONE;
+            }
+            return status;
+        default:
+            return PARSING_BYTECODE_WRONG;
+    }
+}
+
+void transaction_parser_init(tx_parser_t *parser) {
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
+
+    memset(parser, 0, sizeof(*parser));
+    parser->stage = TX_STAGE_HEADER;
+}
+
+parser_status_e transaction_parser_feed(tx_parser_t *parser,
+                                        buffer_t *buf,
+                                        bool last,
+                                        transaction_t *tx) {
+    LEDGER_ASSERT(parser != NULL, "NULL parser");
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+
+    if (buf->size > MAX_TRANSACTION_LEN) {
+        return PARSING_LENGTH_WRONG;
+    }
+
+    parser_status_e status = PARSING_OK;
+    while (status == PARSING_OK && parser->stage != TX_STAGE_DONE) {
+        // Bytes beyond the announced payload and the end opcode can never be valid
+        if (parser->stage > TX_STAGE_PAYLOAD_SIZE &&
+            buf->size > parser->payload_end + ARRAY_LENGTH(OPCODE_END)) {
+            return PARSING_LENGTH_WRONG;
+        }
+        status = transaction_parser_step(parser, buf, last, tx);
+    }
+
+    if (status == PARSING_NEED_MORE) {
+        if (last) {
+            return PARSING_LENGTH_WRONG;
+        }
+        // Only blind signing can still accept a payload whose code could not be walked
+        return parser->opaque_code ? PARSING_TX_NOT_DEFINED : PARSING_OK;
+    }
+    return status;
+}
+
+parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+
+    tx_parser_t parser;
+    transaction_parser_init(&parser);
+    return transaction_parser_feed(&parser, buf, true, tx);
+}
@@ -1,9 +1,45 @@
 #pragma once
 
+#include <stdbool.h>  // bool
+
 #include "buffer.h"
 #include "tx_types.h"
 #include "../types.h"
 
+/**
+ * Reset the resumable transaction parser before the first chunk of a transaction.
+ *
+ * @param[out] parser
+ *   Pointer to parser state.
+ *
+ */
+void transaction_parser_init(tx_parser_t *parser);
+
+/**
+ * Parse the bytes of a transaction received so far.
+ *
+ * The parser resumes where the previous call stopped: header, payload size and the payload
+ * code are checked as they arrive, the tail-anchored parts (contract, method and parameters)
+ * are resolved when `last` is set.
+ *
+ * @param[in, out] parser
+ *   Pointer to parser state, kept between calls.
+ * @param[in, out] buf
+ *   Pointer to buffer with all the bytes of the serialized transaction received so far.
+ * @param[in] last
+ *   Whether the buffer holds the whole transaction.
+ * @param[out] tx
+ *   Pointer to transaction structure.
+ *
+ * @return PARSING_OK if no error has been found so far (if `last`, the transaction has been
+ * fully parsed), error status otherwise.
+ *
+ */
+parser_status_e transaction_parser_feed(tx_parser_t *parser,
+                                        buffer_t *buf,
+                                        bool last,
+                                        transaction_t *tx);
+
 /**
  * Deserialize raw transaction in structure.
  *
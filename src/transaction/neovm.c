@@ -0,0 +1,201 @@
+/*******************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <string.h>
+
+#include "macros.h"
+
+#include "neovm.h"
+#include "tx_types.h"
+#include "constants.h"
+#include "address.h"
+
+#if defined(TEST) || defined(FUZZ)
+#include "assert.h"
+#define LEDGER_ASSERT(x, y) assert(x)
+#else
+#include "ledger_assert.h"
+#endif
+
+/**
+ * Enumeration with the encodings of the operand of an instruction.
+ */
+typedef enum {
+    OPERAND_NONE,
+    OPERAND_INLINE_LEN,  // the opcode is the length of the data which follows
+    OPERAND_U8_LEN,      // 1-byte length followed by the data
+    OPERAND_U16_LEN,     // 2-byte little endian length followed by the data
+    OPERAND_U32_LEN,     // 4-byte little endian length followed by the data
+    OPERAND_VAR_LEN,     // varint length followed by the data
+    OPERAND_OFFSET,      // 2-byte jump offset
+    OPERAND_ADDRESS,     // 20-byte script hash
+} neovm_operand_e;
+
+/**
+ * Structure describing a range of opcodes with the same decoding.
+ */
+typedef struct {
+    uint8_t first;
+    uint8_t last;
+    uint8_t type;     // neovm_token_type_e
+    uint8_t operand;  // neovm_operand_e
+} neovm_opcode_range_t;
+
+// Opcodes not listed here have no operand and decode as NEOVM_TOKEN_OPCODE
+static const neovm_opcode_range_t NEOVM_OPCODES[] = {
+    {0x00, 0x00, NEOVM_TOKEN_PUSH_INT, OPERAND_NONE},          // PUSH0
+    {0x01, 0x4b, NEOVM_TOKEN_PUSH_BYTES, OPERAND_INLINE_LEN},  // PUSHBYTES1-75
+    {0x4c, 0x4c, NEOVM_TOKEN_PUSH_BYTES, OPERAND_U8_LEN},      // PUSHDATA1
+    {0x4d, 0x4d, NEOVM_TOKEN_PUSH_BYTES, OPERAND_U16_LEN},     // PUSHDATA2
+    {0x4e, 0x4e, NEOVM_TOKEN_PUSH_BYTES, OPERAND_U32_LEN},     // PUSHDATA4
+    {0x51, 0x60, NEOVM_TOKEN_PUSH_INT, OPERAND_NONE},          // PUSH1-16
+    {0x62, 0x65, NEOVM_TOKEN_OPCODE, OPERAND_OFFSET},          // JMP, JMPIF, JMPIFNOT, CALL
+    {0x67, 0x67, NEOVM_TOKEN_APPCALL, OPERAND_ADDRESS},        // APPCALL
+    {0x68, 0x68, NEOVM_TOKEN_SYSCALL, OPERAND_VAR_LEN},        // SYSCALL
+    {0x69, 0x69, NEOVM_TOKEN_OPCODE, OPERAND_ADDRESS},         // TAILCALL
+    {0xc1, 0xc1, NEOVM_TOKEN_PACK, OPERAND_NONE},              // PACK
+    {0xc6, 0xc6, NEOVM_TOKEN_NEWSTRUCT, OPERAND_NONE},         // NEWSTRUCT
+};
+
+bool neovm_decode_token(const buffer_t *buf, neovm_token_t *token) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(token != NULL, "NULL token");
+
+    buffer_t ins = *buf;
+    uint8_t opcode = 0;
+    if (!buffer_read_u8(&ins, &opcode)) {
+        return false;
+    }
+
+    neovm_opcode_range_t range = {opcode, opcode, NEOVM_TOKEN_OPCODE, OPERAND_NONE};
+    for (size_t i = 0; i < ARRAY_LENGTH(NEOVM_OPCODES) && opcode >= NEOVM_OPCODES[i].first; i++) {
+        if (opcode <= NEOVM_OPCODES[i].last) {
+            range = NEOVM_OPCODES[i];
+            break;
+        }
+    }
+
+    uint64_t data_len = 0;
+    switch (range.operand) {
+        case OPERAND_INLINE_LEN:
+            data_len = opcode;
+            break;
+        case OPERAND_U8_LEN: {
+            uint8_t n = 0;
+            if (!buffer_read_u8(&ins, &n)) {
+                return false;
+            }
+            data_len = n;
+            break;
+        }
+        case OPERAND_U16_LEN: {
+            uint16_t n = 0;
+            if (!buffer_read_u16(&ins, &n, LE)) {
+                return false;
+            }
+            data_len = n;
+            break;
+        }
+        case OPERAND_U32_LEN: {
+            uint32_t n = 0;
+            if (!buffer_read_u32(&ins, &n, LE)) {
+                return false;
+            }
+            data_len = n;
+            break;
+        }
+        case OPERAND_VAR_LEN:
+            if (!buffer_read_varint(&ins, &data_len)) {
+                return false;
+            }
+            break;
+        case OPERAND_OFFSET:
+            data_len = sizeof(uint16_t);
+            break;
+        case OPERAND_ADDRESS:
+            data_len = ADDRESS_SCRIPT_HASH_LEN;
+            break;
+        default:
+            break;
+    }
+    if (data_len > MAX_TRANSACTION_LEN) {
+        data_len = MAX_TRANSACTION_LEN;  // keep the length below from overflowing, still too long
+    }
+
+    token->type = (neovm_token_type_e) range.type;
+    token->opcode = opcode;
+    token->value = range.type == NEOVM_TOKEN_PUSH_INT && opcode != 0x00
+                       ? (uint8_t) (opcode - OPCODE_PUSH_NUMBER)
+                       : 0;
+    token->offset = buf->offset;
+    token->data_offset = ins.offset;
+    token->data_len = (size_t) data_len;
+    token->len = ins.offset - buf->offset + (size_t) data_len;
+    return true;
+}
+
+bool neovm_read_token(buffer_t *buf, neovm_token_t *token) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(token != NULL, "NULL token");
+
+    return neovm_decode_token(buf, token) && buffer_can_read(buf, token->len) &&
+           buffer_seek_cur(buf, token->len);
+}
+
+bool neovm_read_opcodes(buffer_t *buf, const uint8_t *opcodes, size_t len) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(opcodes != NULL, "NULL opcodes");
+
+    size_t offset = buf->offset;
+    neovm_token_t token;
+    for (size_t i = 0; i < len; i++) {
+        if (!neovm_read_token(buf, &token) || token.len != 1 || token.opcode != opcodes[i]) {
+            buf->offset = offset;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Load 8 bytes of a possibly unaligned buffer
+static inline uint64_t load_u64(const uint8_t *ptr) {
+    uint64_t word;
+    memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
+bool neovm_match_template(buffer_t *buf, const uint8_t *bytes, const uint8_t *mask, size_t len) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(bytes != NULL, "NULL bytes");
+
+    if (!buffer_can_read(buf, len)) {
+        return false;
+    }
+
+    const uint8_t *code = buf->ptr + buf->offset;
+    uint64_t diff = 0;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word = load_u64(code + i) ^ load_u64(bytes + i);
+        diff |= mask != NULL ? word & load_u64(mask + i) : word;
+    }
+    for (; i < len; i++) {
+        uint8_t byte = code[i] ^ bytes[i];
+        diff |= mask != NULL ? byte & mask[i] : byte;
+    }
+    return diff == 0 && buffer_seek_cur(buf, len);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+#include "buffer.h"
+
+/**
+ * Enumeration with the kinds of NeoVM instructions the parser cares about.
+ */
+typedef enum {
+    NEOVM_TOKEN_OPCODE,      // any other instruction, identified by its opcode only
+    NEOVM_TOKEN_PUSH_INT,    // PUSH0, PUSH1-PUSH16: the number is in `value`
+    NEOVM_TOKEN_PUSH_BYTES,  // PUSHBYTES1-75, PUSHDATA1/2/4: the bytes are at `data_offset`
+    NEOVM_TOKEN_PACK,        // PACK
+    NEOVM_TOKEN_NEWSTRUCT,   // NEWSTRUCT
+    NEOVM_TOKEN_APPCALL,     // APPCALL: the contract address is at `data_offset`
+    NEOVM_TOKEN_SYSCALL,     // SYSCALL: the service name is at `data_offset`
+} neovm_token_type_e;
+
+/**
+ * Structure for a decoded NeoVM instruction.
+ */
+typedef struct {
+    neovm_token_type_e type;
+    uint8_t opcode;
+    uint8_t value;       // value pushed by NEOVM_TOKEN_PUSH_INT
+    size_t offset;       // offset of the instruction in the buffer
+    size_t len;          // length of the instruction, operands included
+    size_t data_offset;  // offset of the operand data in the buffer
+    size_t data_len;     // length of the operand data
+} neovm_token_t;
+
+/**
+ * Decode the NeoVM instruction at the current offset of the buffer, without moving it.
+ * Only the bytes encoding the operand length must be readable, the operand itself may not have
+ * been received yet: compare `token->len` with what is left in the buffer.
+ *
+ * @param[in] buf
+ *   Pointer to buffer with the NeoVM code.
+ * @param[out] token
+ *   Pointer to the decoded instruction.
+ * @return true if success, false if the buffer ends before the operand length.
+ */
+bool neovm_decode_token(const buffer_t *buf, neovm_token_t *token);
+
+/**
+ * Read the next NeoVM instruction of the buffer, which must be complete, and move past it.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the NeoVM code.
+ * @param[out] token
+ *   Pointer to the decoded instruction.
+ * @return true if success, false otherwise.
+ */
+bool neovm_read_token(buffer_t *buf, neovm_token_t *token);
+
+/**
+ * Read a sequence of instructions without operands and check their opcodes.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the NeoVM code.
+ * @param[in] opcodes
+ *   Expected opcodes.
+ * @param[in] len
+ *   Number of expected opcodes.
+ * @return true if the instructions match and the buffer moved past them, false otherwise.
+ */
+bool neovm_read_opcodes(buffer_t *buf, const uint8_t *opcodes, size_t len);
+
+/**
+ * Match the code at the current offset of the buffer against a masked template, with a single
+ * bounds check and word-wide compares. Used for the fixed-shape parts of the arguments, where
+ * the wildcard bytes are the pushed data.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the NeoVM code.
+ * @param[in] bytes
+ *   Expected bytes.
+ * @param[in] mask
+ *   0xff where the byte must be equal to the expected one, 0x00 for the wildcard bytes.
+ *   NULL if all the bytes must be equal.
+ * @param[in] len
+ *   Length of the template.
+ * @return true if the code matches and the buffer moved past it, false otherwise.
+ */
+bool neovm_match_template(buffer_t *buf, const uint8_t *bytes, const uint8_t *mask, size_t len);
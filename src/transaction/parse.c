@@ -20,6 +20,10 @@
 #include "parse.h"
 #include "utils.h"
 #include "address.h"
+#include "neovm.h"
+#include "wasm.h"
+
+_Static_assert(MAX_TRANSACTION_LEN <= UINT16_MAX, "parameter offsets are 16-bit");
 
 #if defined(TEST) || defined(FUZZ)
 #include "assert.h"
@@ -28,107 +32,186 @@
 #include "ledger_assert.h"
 #endif
 
-static bool parse_amount(buffer_t *buf, tx_parameter_t *out) {
+// Parse the bytes pushed by a NeoVM instruction, the parameter points to the bytes themselves.
+static bool parse_push_bytes(buffer_t *buf, size_t min_len, size_t max_len, tx_parameter_t *out) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(out != NULL, "NULL out");
+    LEDGER_ASSERT(max_len <= UINT8_MAX, "max_len too large");
 
-    uint8_t amt = 0;
-    if (!buffer_read_u8(buf, &amt)) {
+    neovm_token_t token;
+    if (!neovm_read_token(buf, &token) || token.type != NEOVM_TOKEN_PUSH_BYTES ||
+        token.data_len < min_len || token.data_len > max_len) {
         return false;
     }
 
-    if ((amt > OPCODE_PUSH_NUMBER && amt <= OPCODE_PUSH_NUMBER + 16) || amt == 0) {
-        out->len = 1;
-    } else if (amt > 2 * sizeof(uint64_t)) {
-        return false;
-    } else {
-        out->len = amt + 1;
+    out->len = (uint8_t) token.data_len;
+    out->offset = (uint16_t) token.data_offset;
+    return true;
+}
+
+// Templates of the fixed-shape parts of the native arguments in their usual encoding, with
+// PUSHBYTESn pushes. Other encodings of the pushes are handled by the instruction decoder.
+#define ANY_2 0x00, 0x00
+#define ANY_4 ANY_2, ANY_2
+#define ANY_20 ANY_4, ANY_4, ANY_4, ANY_4, ANY_4
+#define ANY_66 ANY_20, ANY_20, ANY_20, ANY_4, ANY_2
+#define FIX_3 0xff, 0xff, 0xff
+#define FIX_4 FIX_3, 0xff
+#define PARAM_END_BYTES 0x6a, 0x7c, 0xc8
+
+// 14 <from> 6a7cc8 and 42 <pk> 6a7cc8
+static const uint8_t NATIVE_ADDR_PARAM[] = {ADDRESS_SCRIPT_HASH_LEN, ANY_20, PARAM_END_BYTES};
+static const uint8_t NATIVE_ADDR_PARAM_MASK[] = {0xff, ANY_20, FIX_3};
+static const uint8_t NATIVE_PK_PARAM[] = {2 * COMPRESSED_KEY_LEN, ANY_66, PARAM_END_BYTES};
+static const uint8_t NATIVE_PK_PARAM_MASK[] = {0xff, ANY_66, FIX_3};
+
+// 00c66b 14 <from> 6a7cc8 14 <to> 6a7cc8, followed by <amount> 6a7cc8 6c
+static const uint8_t TRANSFER_STATE_HEAD[] =
+    {0x00, 0xc6, 0x6b, ADDRESS_SCRIPT_HASH_LEN, ANY_20, PARAM_END_BYTES, ADDRESS_SCRIPT_HASH_LEN,
+     ANY_20, PARAM_END_BYTES};
+static const uint8_t TRANSFER_STATE_HEAD_MASK[] = {FIX_4, ANY_20, FIX_4, ANY_20, FIX_3};
+static const uint8_t TRANSFER_STATE_TAIL[] = {PARAM_END_BYTES, 0x6c};
+#define TRANSFER_STATE_FROM_OFFSET 4
+#define TRANSFER_STATE_TO_OFFSET (TRANSFER_STATE_FROM_OFFSET + ADDRESS_SCRIPT_HASH_LEN + 4)
+
+_Static_assert(sizeof(NATIVE_ADDR_PARAM) == sizeof(NATIVE_ADDR_PARAM_MASK), "template mask");
+_Static_assert(sizeof(NATIVE_PK_PARAM) == sizeof(NATIVE_PK_PARAM_MASK), "template mask");
+_Static_assert(sizeof(TRANSFER_STATE_HEAD) == sizeof(TRANSFER_STATE_HEAD_MASK), "template mask");
+
+// Parse a native parameter made of a push of fixed length followed by 6a7cc8, the template being
+// the one of the PUSHBYTESn encoding. The parameter points to the pushed bytes.
+static bool parse_native_push_param(buffer_t *buf,
+                                    const uint8_t *tmpl,
+                                    const uint8_t *mask,
+                                    size_t tmpl_len,
+                                    tx_parameter_type_e type,
+                                    tx_parameter_t *out) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+
+    size_t data_len = tmpl_len - 1 - ARRAY_LENGTH(OPCODE_PARAM_END);
+    size_t start = buf->offset;
+    out->type = type;
+    if (neovm_match_template(buf, tmpl, mask, tmpl_len)) {
+        out->len = (uint8_t) data_len;
+        out->offset = (uint16_t) (start + 1);
+        return true;
     }
+    return parse_push_bytes(buf, data_len, data_len, out) &&
+           neovm_read_opcodes(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END));
+}
 
-    out->data = (uint8_t *) (buf->ptr + buf->offset - 1);
-    out->type = PARAM_AMOUNT;
-    return buffer_seek_cur(buf, out->len - 1);
+static bool parse_native_address(buffer_t *buf, tx_parameter_t *out) {
+    return parse_native_push_param(buf,
+                                   NATIVE_ADDR_PARAM,
+                                   NATIVE_ADDR_PARAM_MASK,
+                                   sizeof(NATIVE_ADDR_PARAM),
+                                   PARAM_ADDR,
+                                   out);
 }
 
-static bool parse_get_amount(buffer_t *buf, uint64_t *out) {
+static bool parse_native_pk(buffer_t *buf, tx_parameter_t *out) {
+    return parse_native_push_param(buf,
+                                   NATIVE_PK_PARAM,
+                                   NATIVE_PK_PARAM_MASK,
+                                   sizeof(NATIVE_PK_PARAM),
+                                   PARAM_PUBKEY,
+                                   out);
+}
+
+// An amount is a PUSH0-PUSH16 instruction or a push of up to 16 bytes, the parameter covers the
+// whole instruction.
+static bool parse_amount(buffer_t *buf, tx_parameter_t *out) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    tx_parameter_t tmp;
-    return parse_amount(buf, &tmp) && convert_param_to_uint64_le(&tmp, out);
+    neovm_token_t token;
+    if (!neovm_read_token(buf, &token) ||
+        (token.type != NEOVM_TOKEN_PUSH_INT &&
+         (token.type != NEOVM_TOKEN_PUSH_BYTES || token.data_len == 0 ||
+          token.data_len > 2 * sizeof(uint64_t)))) {
+        return false;
+    }
+
+    out->len = (uint8_t) token.len;
+    out->offset = (uint16_t) token.offset;
+    out->type = PARAM_AMOUNT;
+    return true;
 }
 
-static bool parse_uint128(buffer_t *buf, tx_parameter_t *out) {
+static bool parse_get_amount(buffer_t *buf, uint64_t *out) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    const uint8_t size = 16;
-    if (!buffer_can_read(buf, size)) return false;
-
-    out->len = size;
-    out->data = (uint8_t *) (buf->ptr + buf->offset);
-    out->type = PARAM_UINT128;
-    return buffer_seek_cur(buf, size);
+    tx_parameter_t tmp;
+    return parse_amount(buf, &tmp) && convert_param_to_uint64_le(buf->ptr, &tmp, out);
 }
 
 static bool parse_pk(buffer_t *buf, tx_parameter_t *out) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    uint8_t size = 0;
-    if (!buffer_read_u8(buf, &size) || size != 2 * COMPRESSED_KEY_LEN ||
-        !buffer_can_read(buf, 2 * COMPRESSED_KEY_LEN)) {
-        return false;
-    }
-
-    out->len = size;
-    out->data = (uint8_t *) (buf->ptr + buf->offset);
     out->type = PARAM_PUBKEY;
-    return buffer_seek_cur(buf, size);
+    return parse_push_bytes(buf, 2 * COMPRESSED_KEY_LEN, 2 * COMPRESSED_KEY_LEN, out);
 }
 
 static bool parse_ont_id(buffer_t *buf) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
 
-    uint8_t size = 0;
-    return buffer_read_u8(buf, &size) && size != 0 && buffer_seek_cur(buf, size);
+    tx_parameter_t tmp;
+    return parse_push_bytes(buf, 1, UINT8_MAX, &tmp);
 }
 
-static bool parse_pk_amount_pairs(buffer_t *buf, tx_parameter_t *pairs, size_t *cur) {
+// Validate the pk/amount pairs and record them as the group of the method.
+// The public keys are followed by the amounts, both lists are prefixed by their count.
+// Public keys already validated in `run` are stepped over.
+static bool parse_pk_amount_pairs(buffer_t *buf,
+                                  const tx_group_run_t *run,
+                                  tx_param_group_t *group) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
-    LEDGER_ASSERT(pairs != NULL, "NULL pairs");
-    LEDGER_ASSERT(cur != NULL, "NULL cur");
+    LEDGER_ASSERT(run != NULL, "NULL run");
+    LEDGER_ASSERT(group != NULL, "NULL group");
 
     uint64_t pks_num = 0;
+    tx_parameter_t tmp;
 
-    if (!parse_amount(buf, &pairs[0]) || !convert_param_to_uint64_le(&pairs[0], &pks_num) ||
-        pks_num == 0 ||
-        pks_num * 2 + 1 + *cur > PARAMETERS_MAX_NUM ||
-        !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
+    if (!parse_get_amount(buf, &pks_num) || pks_num == 0 || pks_num > UINT16_MAX ||
+        !neovm_read_opcodes(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
         return false;
     }
 
-    for (size_t i = 1; i <= pks_num; i++) {
-        if (!parse_pk(buf, &pairs[i]) ||
-            !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
-            return false;
+    group->offset = (uint16_t) buf->offset;
+    if (run->count == pks_num && run->offset == buf->offset) {
+        buffer_seek_set(buf, run->end);
+    } else {
+        for (size_t i = 1; i <= pks_num; i++) {
+            if (!parse_native_pk(buf, &tmp)) {
+                return false;
+            }
         }
     }
 
     if (!parse_check_amount(buf, pks_num) ||
-        !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
+        !neovm_read_opcodes(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
         return false;
     }
 
+    group->values_offset = (uint16_t) buf->offset;
+    group->total = (amount_t) {0};
     for (size_t i = 1; i <= pks_num; i++) {
-        if (!parse_amount(buf, &pairs[pks_num + i]) ||
+        amount_t value;
+        if (!parse_amount(buf, &tmp) || !convert_param_to_amount(buf->ptr, &tmp, true, &value) ||
+            !amount_add(&group->total, &value) ||
             (i != pks_num &&
-             !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)))) {
+             !neovm_read_opcodes(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)))) {
             return false;
         }
     }
 
-    *cur += (pks_num * 2 + 1);
+    group->end = (uint16_t) buf->offset;
+    group->count = (uint16_t) pks_num;
+    group->cursor_index = 0;
+    group->cursor_offset = group->values_offset;
     return true;
 }
 
@@ -145,16 +228,16 @@ bool parse_address(buffer_t *buf, bool has_length, tx_parameter_t *out) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    size_t prefix_len = has_length ? 1 : 0;
-    uint8_t size = 0;
-
-    if (!buffer_can_read(buf, ADDRESS_SCRIPT_HASH_LEN + prefix_len) ||
-        (has_length && (!buffer_read_u8(buf, &size) || size != ADDRESS_SCRIPT_HASH_LEN))) {
+    out->type = PARAM_ADDR;
+    if (has_length) {
+        return parse_push_bytes(buf, ADDRESS_SCRIPT_HASH_LEN, ADDRESS_SCRIPT_HASH_LEN, out);
+    }
+    if (!buffer_can_read(buf, ADDRESS_SCRIPT_HASH_LEN)) {
         return false;
     }
 
     out->len = ADDRESS_SCRIPT_HASH_LEN;
-    out->data = (uint8_t *) (buf->ptr + buf->offset);
+    out->offset = (uint16_t) buf->offset;
     out->type = PARAM_ADDR;
     return buffer_seek_cur(buf, ADDRESS_SCRIPT_HASH_LEN);
 }
@@ -166,18 +249,14 @@ bool parse_check_amount(buffer_t *buf, uint64_t num) {
     return parse_get_amount(buf, &out) && out == num;
 }
 
-bool parse_method_name(buffer_t *buf, tx_parameter_t *out) {
+bool parse_method_name(buffer_t *buf, bool is_neovm_code, tx_parameter_t *out) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
     LEDGER_ASSERT(out != NULL, "NULL out");
 
-    uint8_t size = 0;
-    if (!buffer_read_u8(buf, &size) || size == 0 || !buffer_can_read(buf, size)) {
-        return false;
+    if (is_neovm_code) {
+        return parse_push_bytes(buf, 1, UINT8_MAX, out);
     }
-
-    out->len = size;
-    out->data = (uint8_t *) (buf->ptr + buf->offset);
-    return buffer_seek_cur(buf, size);
+    return wasm_read_bytes(buf, UINT8_MAX, out) && out->len != 0;
 }
 
 bool parse_trasfer_state(buffer_t *buf, tx_parameter_t *transfer_state, size_t *cur) {
@@ -185,15 +264,28 @@ bool parse_trasfer_state(buffer_t *buf, tx_parameter_t *transfer_state, size_t *
     LEDGER_ASSERT(transfer_state != NULL, "NULL transfer_state");
     LEDGER_ASSERT(cur != NULL, "NULL cur");
 
-    if ((*cur + 3 > PARAMETERS_MAX_NUM) ||
-        !parse_check_constant(buf, OPCODE_ST_BEGIN, ARRAY_LENGTH(OPCODE_ST_BEGIN)) ||
-        !parse_address(buf, true, &transfer_state[0]) ||
-        !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)) ||
-        !parse_address(buf, true, &transfer_state[1]) ||
-        !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)) ||
-        !parse_amount(buf, &transfer_state[2]) ||
-        !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)) ||
-        !parse_check_constant(buf, OPCODE_ST_END, ARRAY_LENGTH(OPCODE_ST_END))) {
+    if (*cur + 3 > PARAMETERS_MAX_NUM) {
+        return false;
+    }
+
+    size_t start = buf->offset;
+    if (neovm_match_template(buf,
+                             TRANSFER_STATE_HEAD,
+                             TRANSFER_STATE_HEAD_MASK,
+                             sizeof(TRANSFER_STATE_HEAD))) {
+        transfer_state[0].type = PARAM_ADDR;
+        transfer_state[0].len = ADDRESS_SCRIPT_HASH_LEN;
+        transfer_state[0].offset = (uint16_t) (start + TRANSFER_STATE_FROM_OFFSET);
+        transfer_state[1] = transfer_state[0];
+        transfer_state[1].offset = (uint16_t) (start + TRANSFER_STATE_TO_OFFSET);
+    } else if (!neovm_read_opcodes(buf, OPCODE_ST_BEGIN, ARRAY_LENGTH(OPCODE_ST_BEGIN)) ||
+               !parse_native_address(buf, &transfer_state[0]) ||
+               !parse_native_address(buf, &transfer_state[1])) {
+        return false;
+    }
+
+    if (!parse_amount(buf, &transfer_state[2]) ||
+        !neovm_match_template(buf, TRANSFER_STATE_TAIL, NULL, sizeof(TRANSFER_STATE_TAIL))) {
         return false;
     }
 
@@ -201,71 +293,204 @@ bool parse_trasfer_state(buffer_t *buf, tx_parameter_t *transfer_state, size_t *
     return true;
 }
 
-bool parse_method_params(buffer_t *buf,
-                         transaction_t *tx,
-                         const tx_parameter_type_e *params,
-                         size_t *params_num) {
+bool parse_transfer_state_list(buffer_t *buf,
+                               const tx_group_run_t *run,
+                               tx_param_group_t *group) {
     LEDGER_ASSERT(buf != NULL, "NULL buf");
-    LEDGER_ASSERT(tx != NULL, "NULL tx");
-    LEDGER_ASSERT(params != NULL, "NULL params");
-    LEDGER_ASSERT(params_num != NULL, "NULL params_num");
+    LEDGER_ASSERT(group != NULL, "NULL group");
 
-    size_t cur = 0;
-    *params_num = 0;
+    tx_parameter_t transfer_state[3];
+    size_t num = 0;
 
-    for (; *params != PARAM_END; ++params) {
-        (*params_num)++;
-        if (cur >= PARAMETERS_MAX_NUM) {
+    neovm_token_t token;
+    group->offset = (uint16_t) buf->offset;
+    if (run != NULL && run->count != 0 && run->offset == buf->offset) {
+        num = run->count;
+        buffer_seek_set(buf, run->end);
+    }
+    while (neovm_decode_token(buf, &token) && token.opcode == OPCODE_ST_BEGIN[0]) {
+        size_t cur = 0;
+        if (num >= TRANSFER_STATES_MAX_NUM || !parse_trasfer_state(buf, transfer_state, &cur)) {
             return false;
         }
-        switch (*params) {
-            case PARAM_ADDR:
-                if (!parse_address(buf,
-                                   tx->contract.type != WASMVM_CONTRACT,
-                                   &tx->method.parameters[cur++])) {
-                    return false;
-                }
-                break;
-            case PARAM_AMOUNT:
-                if (!parse_amount(buf, &tx->method.parameters[cur++])) {
-                    return false;
-                }
-                break;
-            case PARAM_UINT128:
-                if (!parse_uint128(buf, &tx->method.parameters[cur++])) {
-                    return false;
-                }
-                break;
-            case PARAM_PUBKEY:
-                if (!parse_pk(buf, &tx->method.parameters[cur++])) {
-                    return false;
-                }
-                break;
-            case PARAM_ONTID:
-                if (!parse_ont_id(buf)) {
-                    return false;
-                }
-                break;
-            case PARAM_PK_AMOUNT_PAIRS:
-                if (!parse_pk_amount_pairs(buf, &tx->method.parameters[cur], &cur)) {
-                    return false;
-                }
-                break;
-            case PARAM_TRANSFER_STATE:
-                if (!parse_trasfer_state(buf, &tx->method.parameters[cur], &cur)) {
-                    return false;
-                }
-                break;
-
-            default:
-                return false;
+        num++;
+    }
+    group->end = (uint16_t) buf->offset;
+    group->count = (uint16_t) num;
+    group->cursor_index = 0;
+    group->cursor_offset = group->offset;
+
+    return parse_check_amount(buf, num);
+}
+
+// Position a buffer on the element `index` of a group, starting from the cursor when possible
+// or from the element 0 located at `first`. `skip` steps over one element.
+static bool group_seek(const transaction_t *tx,
+                       tx_param_group_t *group,
+                       size_t first,
+                       uint16_t index,
+                       bool (*skip)(buffer_t *buf),
+                       buffer_t *buf) {
+    if (index >= group->count) {
+        return false;
+    }
+    if (index < group->cursor_index) {
+        group->cursor_index = 0;
+        group->cursor_offset = (uint16_t) first;
+    }
+
+    buf->ptr = tx->raw;
+    buf->size = group->end;
+    buf->offset = group->cursor_offset;
+    while (group->cursor_index < index) {
+        if (!skip(buf)) {
+            return false;
         }
+        group->cursor_index++;
+        group->cursor_offset = (uint16_t) buf->offset;
+    }
+    return true;
+}
+
+bool parse_skip_transfer_state(buffer_t *buf) {
+    tx_parameter_t transfer_state[3];
+    size_t cur = 0;
+    return parse_trasfer_state(buf, transfer_state, &cur);
+}
+
+bool parse_transfer_state_at(transaction_t *tx, uint16_t index, tx_parameter_t *transfer_state) {
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+    LEDGER_ASSERT(transfer_state != NULL, "NULL transfer_state");
+
+    tx_param_group_t *group = &tx->method.group;
+    buffer_t buf = {0};
+    size_t cur = 0;
+    return group_seek(tx, group, group->offset, index, parse_skip_transfer_state, &buf) &&
+           parse_trasfer_state(&buf, transfer_state, &cur);
+}
 
-        if (tx->contract.type == NATIVE_CONTRACT &&
-            !parse_check_constant(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
+static bool skip_amount(buffer_t *buf) {
+    tx_parameter_t amount;
+    return parse_amount(buf, &amount) &&
+           neovm_read_opcodes(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END));
+}
+
+bool parse_skip_native_pk(buffer_t *buf) {
+    tx_parameter_t pk;
+    return parse_native_pk(buf, &pk);
+}
+
+bool parse_pk_amount_pair_at(transaction_t *tx,
+                             uint16_t index,
+                             tx_parameter_t *pk,
+                             tx_parameter_t *amount) {
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+    LEDGER_ASSERT(amount != NULL, "NULL amount");
+
+    tx_param_group_t *group = &tx->method.group;
+    if (index >= group->count) {
+        return false;
+    }
+
+    // Only the first public keys are displayed, they are walked from the start of the group.
+    // The cursor walks the amounts, which are all read to compute the total.
+    if (pk != NULL) {
+        buffer_t buf = {.ptr = tx->raw, .size = group->values_offset, .offset = group->offset};
+        for (uint16_t i = 0; i < index; i++) {
+            if (!parse_skip_native_pk(&buf)) {
+                return false;
+            }
+        }
+        if (!parse_pk(&buf, pk)) {
             return false;
         }
     }
 
-    return true;
+    buffer_t buf = {0};
+    return group_seek(tx, group, group->values_offset, index, skip_amount, &buf) &&
+           parse_amount(&buf, amount);
+}
+
+// Steps of the generated parsers, each parsing one parameter into `tx->method.parameters[cur]`
+#define PARSE_PARAM_ADDR(buf, tx, cur) parse_address(buf, true, &(tx)->method.parameters[(cur)++])
+#define PARSE_PARAM_AMOUNT(buf, tx, cur) parse_amount(buf, &(tx)->method.parameters[(cur)++])
+#define PARSE_PARAM_PUBKEY(buf, tx, cur) parse_pk(buf, &(tx)->method.parameters[(cur)++])
+#define PARSE_PARAM_ONTID(buf, tx, cur) parse_ont_id(buf)
+#define PARSE_PARAM_PK_AMOUNT_PAIRS(buf, tx, cur) \
+    parse_pk_amount_pairs(buf, &(tx)->method.pk_run, &(tx)->method.group)
+#define PARSE_PARAM_TRANSFER_STATE(buf, tx, cur) \
+    parse_trasfer_state(buf, &(tx)->method.parameters[cur], &(cur))
+#define PARSE_WASM_PARAM_ADDR(buf, tx, cur) \
+    wasm_read_address(buf, &(tx)->method.parameters[(cur)++])
+#define PARSE_WASM_PARAM_UINT128(buf, tx, cur) \
+    wasm_read_u128(buf, &(tx)->method.parameters[(cur)++])
+
+// Number of slots of `tx->method.parameters` used by each parameter type
+#define PARAM_SLOTS_ADDR 1
+#define PARAM_SLOTS_AMOUNT 1
+#define PARAM_SLOTS_PUBKEY 1
+#define PARAM_SLOTS_UINT128 1
+#define PARAM_SLOTS_ONTID 0
+#define PARAM_SLOTS_PK_AMOUNT_PAIRS 0
+#define PARAM_SLOTS_TRANSFER_STATE 3
+#define COUNT_PARAM_SLOTS(type) +PARAM_SLOTS_##type
+#define COUNT_PARAM(type) +1
+
+// Native steps also read the 6a7cc8 following the parameter, fused in the template match of the
+// fixed-shape parameters
+#define PARSE_NATIVE_PARAM_ADDR(buf, tx, cur) \
+    parse_native_address(buf, &(tx)->method.parameters[(cur)++])
+#define PARSE_NATIVE_PARAM_PUBKEY(buf, tx, cur) \
+    parse_native_pk(buf, &(tx)->method.parameters[(cur)++])
+#define PARSE_NATIVE_PARAM_SEPARATED(type, buf, tx, cur) \
+    (PARSE_PARAM_##type(buf, tx, cur) &&                 \
+     neovm_read_opcodes(buf, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)))
+#define PARSE_NATIVE_PARAM_AMOUNT(buf, tx, cur) PARSE_NATIVE_PARAM_SEPARATED(AMOUNT, buf, tx, cur)
+#define PARSE_NATIVE_PARAM_ONTID(buf, tx, cur) PARSE_NATIVE_PARAM_SEPARATED(ONTID, buf, tx, cur)
+#define PARSE_NATIVE_PARAM_PK_AMOUNT_PAIRS(buf, tx, cur) \
+    PARSE_NATIVE_PARAM_SEPARATED(PK_AMOUNT_PAIRS, buf, tx, cur)
+#define PARSE_NATIVE_PARAM_TRANSFER_STATE(buf, tx, cur) \
+    PARSE_NATIVE_PARAM_SEPARATED(TRANSFER_STATE, buf, tx, cur)
+
+#define NATIVE_PARAM_STEP(type)                     \
+    if (!PARSE_NATIVE_PARAM_##type(buf, tx, cur)) { \
+        return false;                               \
+    }
+#define NEOVM_PARAM_STEP(type)               \
+    if (!PARSE_PARAM_##type(buf, tx, cur)) { \
+        return false;                        \
+    }
+#define WASMVM_PARAM_STEP(type)                   \
+    if (!PARSE_WASM_PARAM_##type(buf, tx, cur)) { \
+        return false;                             \
+    }
+
+#define NATIVE_PARAMS_TAIL(PARAMS) true
+#define NEOVM_PARAMS_TAIL(PARAMS)                  \
+    (parse_check_amount(buf, 0 PARAMS(COUNT_PARAM)) && \
+     neovm_read_opcodes(buf, OPCODE_PACK, ARRAY_LENGTH(OPCODE_PACK)))
+#define WASMVM_PARAMS_TAIL(PARAMS) true
+
+// One straight-line function per signature: the contract type is resolved when generating it,
+// and the slots of the parameters are constants.
+#define DEFINE_PARAMS_PARSER(vm, name, PARAMS)                        \
+    _Static_assert(0 PARAMS(COUNT_PARAM_SLOTS) <= PARAMETERS_MAX_NUM, \
+                   "too many parameters for " #name);                 \
+    bool parse_params_##name(buffer_t *buf, transaction_t *tx) {      \
+        LEDGER_ASSERT(buf != NULL, "NULL buf");                       \
+        LEDGER_ASSERT(tx != NULL, "NULL tx");                         \
+                                                                      \
+        size_t cur = 0;                                               \
+        PARAMS(vm##_PARAM_STEP)                                       \
+        return vm##_PARAMS_TAIL(PARAMS);                              \
+    }
+
+TX_METHOD_SIGNATURES(DEFINE_PARAMS_PARSER)
+
+bool parse_params_native_transfer(buffer_t *buf, transaction_t *tx) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(tx != NULL, "NULL tx");
+
+    return parse_transfer_state_list(buf, &tx->method.transfer_run, &tx->method.group) &&
+           neovm_read_opcodes(buf, OPCODE_PACK, ARRAY_LENGTH(OPCODE_PACK));
 }
@@ -5,27 +5,33 @@
 
 #include "types.h"
 #include "tx_types.h"
+#include "contract.h"
 
 /**
- * Parse the parameters of a method according to the parameter types.
+ * Parse the arguments of a registered method, one function per entry of TX_METHOD_SIGNATURES.
+ * Native arguments are each followed by 6a7cc8, NeoVM ones by their count and PACK.
  *
  * @param[in] buf
  *   Pointer to buffer with serialized parameters.
  * @param[out] tx
  *   Pointer to transaction structure.
- * @param[in] params
- *   Array of parameter types, terminated by PARAM_END.
- * @param[out] params_num
- *   Number of parameters parsed.
- *   It is only used to check when the transaction is a neovm contract transaction.
- *   It is NOT right to use it to get the number of parameters for other types of transactions.
- *   The parameters of a neovm contract transaction are simple types, not composite types.
  * @return true if success, false otherwise.
  */
-bool parse_method_params(buffer_t *buf,
-                         transaction_t *tx,
-                         const tx_parameter_type_e *params,
-                         size_t *params_num);
+#define DECLARE_PARAMS_PARSER(vm, name, PARAMS) \
+    bool parse_params_##name(buffer_t *buf, transaction_t *tx);
+TX_METHOD_SIGNATURES(DECLARE_PARAMS_PARSER)
+
+/**
+ * Parse the arguments of the native transfer and transferV2 methods, a list of transfer states
+ * followed by PACK.
+ *
+ * @param[in] buf
+ *   Pointer to buffer with serialized parameters.
+ * @param[out] tx
+ *   Pointer to transaction structure.
+ * @return true if success, false otherwise.
+ */
+bool parse_params_native_transfer(buffer_t *buf, transaction_t *tx);
 
 /**
  * Check if the next bytes in the buffer match a constant string.
@@ -70,11 +76,13 @@ bool parse_trasfer_state(buffer_t *buf, tx_parameter_t *transfer_state, size_t *
  *
  * @param[in] buf
  *   Pointer to buffer with serialized method name.
+ * @param[in] is_neovm_code
+ *   Whether the method name is pushed by a NeoVM instruction, or prefixed with a length byte.
  * @param[out] method_name
  *   Parameter structure to store the parsed method name.
  * @return true if success, false otherwise.
  */
-bool parse_method_name(buffer_t *buf, tx_parameter_t *method_name);
+bool parse_method_name(buffer_t *buf, bool is_neovm_code, tx_parameter_t *method_name);
 
 /**
  * Parse an address from the buffer.
@@ -88,3 +96,68 @@ bool parse_method_name(buffer_t *buf, tx_parameter_t *method_name);
  * @return true if success, false otherwise.
  */
 bool parse_address(buffer_t *buf, bool has_length, tx_parameter_t *out);
+
+/**
+ * Validate a list of transfer states followed by their count, and record it as a group.
+ * The transfer states are not stored, see `parse_transfer_state_at`.
+ *
+ * @param[in] buf
+ *   Pointer to buffer with serialized transfer states.
+ * @param[in] run
+ *   Transfer states already validated, stepped over if the run starts the list. May be NULL.
+ * @param[out] group
+ *   Group describing the transfer states in the raw transaction.
+ * @return true if success, false otherwise.
+ */
+bool parse_transfer_state_list(buffer_t *buf,
+                               const tx_group_run_t *run,
+                               tx_param_group_t *group);
+
+/**
+ * Validate a transfer state and move past it.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized transfer state.
+ * @return true if success, false otherwise.
+ */
+bool parse_skip_transfer_state(buffer_t *buf);
+
+/**
+ * Validate a public key of a native parameter, followed by 6a7cc8, and move past it.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized public key.
+ * @return true if success, false otherwise.
+ */
+bool parse_skip_native_pk(buffer_t *buf);
+
+/**
+ * Decode the transfer state `index` of the group of the transaction.
+ *
+ * @param[in,out] tx
+ *   Pointer to transaction structure, the cursor of its group is updated.
+ * @param[in] index
+ *   Index of the transfer state in the group.
+ * @param[out] transfer_state
+ *   Array of 3 parameters: from address, to address and amount.
+ * @return true if success, false otherwise.
+ */
+bool parse_transfer_state_at(transaction_t *tx, uint16_t index, tx_parameter_t *transfer_state);
+
+/**
+ * Decode the pk/amount pair `index` of the group of the transaction.
+ *
+ * @param[in,out] tx
+ *   Pointer to transaction structure, the cursor of its group is updated.
+ * @param[in] index
+ *   Index of the pair in the group.
+ * @param[out] pk
+ *   Parameter of the public key, NULL if only the amount is needed.
+ * @param[out] amount
+ *   Parameter of the amount.
+ * @return true if success, false otherwise.
+ */
+bool parse_pk_amount_pair_at(transaction_t *tx,
+                             uint16_t index,
+                             tx_parameter_t *pk,
+                             tx_parameter_t *amount);
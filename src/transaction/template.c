@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <string.h>
+
+#include "macros.h"
+
+#include "template.h"
+#include "neovm.h"
+#include "tx_types.h"
+
+#if defined(TEST) || defined(FUZZ)
+#include "assert.h"
+#define LEDGER_ASSERT(x, y) assert(x)
+#else
+#include "ledger_assert.h"
+#endif
+
+// PUSHBYTES20, the opcode is the length of the pushed address
+static const uint8_t OPCODE_PUSH_ADDRESS[] = {ADDRESS_SCRIPT_HASH_LEN};
+
+static bool append(uint8_t *out, size_t out_size, size_t *len, const uint8_t *data, size_t n) {
+    if (n > out_size - *len) {
+        return false;
+    }
+    memcpy(out + *len, data, n);
+    *len += n;
+    return true;
+}
+
+// Append bytes of the input as they are
+static bool copy_input(buffer_t *in, uint8_t *out, size_t out_size, size_t *len, size_t n) {
+    return buffer_can_read(in, n) && append(out, out_size, len, in->ptr + in->offset, n) &&
+           buffer_seek_cur(in, n);
+}
+
+static bool read_flags(buffer_t *in, uint8_t *flags) {
+    return buffer_read_u8(in, flags) && (*flags & ~TX_TEMPLATE_REPEAT_ADDRESS) == 0;
+}
+
+// Read an address sent in full, which can then be repeated, or take the repeated one
+static bool read_address(tx_template_t *ctx, buffer_t *in, uint8_t flags) {
+    if (flags & TX_TEMPLATE_REPEAT_ADDRESS) {
+        return ctx->has_address;
+    }
+    if (!buffer_can_read(in, ADDRESS_SCRIPT_HASH_LEN)) {
+        return false;
+    }
+    memcpy(ctx->address, in->ptr + in->offset, ADDRESS_SCRIPT_HASH_LEN);
+    ctx->has_address = true;
+    return buffer_seek_cur(in, ADDRESS_SCRIPT_HASH_LEN);
+}
+
+static bool decode_header(tx_template_t *ctx,
+                          buffer_t *in,
+                          uint8_t *out,
+                          size_t out_size,
+                          size_t *len) {
+    uint8_t flags = 0;
+    return read_flags(in, &flags) &&
+           copy_input(in, out, out_size, len, TX_HEADER_LEN - ADDRESS_SCRIPT_HASH_LEN) &&
+           read_address(ctx, in, flags) &&
+           append(out, out_size, len, ctx->address, ADDRESS_SCRIPT_HASH_LEN);
+}
+
+static bool decode_transfer_state(tx_template_t *ctx,
+                                  buffer_t *in,
+                                  uint8_t *out,
+                                  size_t out_size,
+                                  size_t *len) {
+    uint8_t flags = 0;
+    if (!read_flags(in, &flags) || !read_address(ctx, in, flags) ||
+        !append(out, out_size, len, OPCODE_ST_BEGIN, ARRAY_LENGTH(OPCODE_ST_BEGIN)) ||
+        !append(out, out_size, len, OPCODE_PUSH_ADDRESS, ARRAY_LENGTH(OPCODE_PUSH_ADDRESS)) ||
+        !append(out, out_size, len, ctx->address, ADDRESS_SCRIPT_HASH_LEN) ||
+        !append(out, out_size, len, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END)) ||
+        !append(out, out_size, len, OPCODE_PUSH_ADDRESS, ARRAY_LENGTH(OPCODE_PUSH_ADDRESS)) ||
+        !copy_input(in, out, out_size, len, ADDRESS_SCRIPT_HASH_LEN) ||
+        !append(out, out_size, len, OPCODE_PARAM_END, ARRAY_LENGTH(OPCODE_PARAM_END))) {
+        return false;
+    }
+
+    neovm_token_t amount;
+    if (!neovm_decode_token(in, &amount) ||
+        (amount.type != NEOVM_TOKEN_PUSH_INT && amount.type != NEOVM_TOKEN_PUSH_BYTES)) {
+        return false;
+    }
+    return copy_input(in, out, out_size, len, amount.len) &&
+           append(out, out_size, len, OPCODE_PARAM_ST_END, ARRAY_LENGTH(OPCODE_PARAM_ST_END));
+}
+
+static bool decode_native_tail(buffer_t *in, uint8_t *out, size_t out_size, size_t *len) {
+    uint8_t contract[ADDRESS_SCRIPT_HASH_LEN] = {0};
+    if (!buffer_read_u8(in, &contract[ADDRESS_SCRIPT_HASH_LEN - 1])) {
+        return false;
+    }
+    return append(out, out_size, len, OPCODE_PUSH_ADDRESS, ARRAY_LENGTH(OPCODE_PUSH_ADDRESS)) &&
+           append(out, out_size, len, contract, sizeof(contract)) &&
+           append(out, out_size, len, OPCODE_SYSCALL, ARRAY_LENGTH(OPCODE_SYSCALL)) &&
+           append(out, out_size, len, NATIVE_INVOKE, ARRAY_LENGTH(NATIVE_INVOKE)) &&
+           append(out, out_size, len, OPCODE_END, ARRAY_LENGTH(OPCODE_END));
+}
+
+bool tx_template_decode(tx_template_t *ctx,
+                        buffer_t *in,
+                        uint8_t *out,
+                        size_t out_size,
+                        size_t *out_len) {
+    LEDGER_ASSERT(ctx != NULL, "NULL ctx");
+    LEDGER_ASSERT(in != NULL, "NULL in");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+    LEDGER_ASSERT(out_len != NULL && *out_len <= out_size, "Wrong out_len");
+
+    size_t len = *out_len;
+    while (in->offset < in->size) {
+        uint8_t op = 0;
+        uint8_t n = 0;
+        bool res = false;
+        if (!buffer_read_u8(in, &op)) {
+            return false;
+        }
+        switch (op) {
+            case TX_TEMPLATE_LITERAL:
+                res = buffer_read_u8(in, &n) && copy_input(in, out, out_size, &len, n);
+                break;
+            case TX_TEMPLATE_HEADER:
+                res = decode_header(ctx, in, out, out_size, &len);
+                break;
+            case TX_TEMPLATE_TRANSFER_STATE:
+                res = decode_transfer_state(ctx, in, out, out_size, &len);
+                break;
+            case TX_TEMPLATE_NATIVE_TAIL:
+                res = decode_native_tail(in, out, out_size, &len);
+                break;
+            default:
+                break;
+        }
+        if (!res) {
+            return false;
+        }
+    }
+    *out_len = len;
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+#include "buffer.h"
+#include "address.h"
+
+/*
+ * Template encoding of a transaction upload. Instead of the raw bytes, the host sends a
+ * sequence of operations, each one whole within an APDU, and the device rebuilds the exact
+ * canonical bytes before hashing and parsing them:
+ * - LITERAL: length (1) || bytes, copied as they are.
+ * - HEADER: flags (1) || version (1) || tx type (1) || nonce (4) || gas price (8) ||
+ *   gas limit (8) || payer (20, absent with TX_TEMPLATE_REPEAT_ADDRESS).
+ * - TRANSFER_STATE: flags (1) || from (20, absent with TX_TEMPLATE_REPEAT_ADDRESS) ||
+ *   to (20) || amount, as the NeoVM push instruction of the raw transaction.
+ *   Rebuilt as 00c66b 14 <from> 6a7cc8 14 <to> 6a7cc8 <amount> 6a7cc8 6c.
+ * - NATIVE_TAIL: last byte of the native contract address (1). Rebuilt as the 47 bytes
+ *   14 <contract> 0068 16 "Ontology.Native.Invoke" 00 ending the transaction.
+ * A repeated address is the last payer or from sent in full, within the same upload.
+ */
+
+/**
+ * Enumeration with the operations of the template encoding.
+ */
+typedef enum {
+    TX_TEMPLATE_LITERAL = 0x00,
+    TX_TEMPLATE_HEADER = 0x01,
+    TX_TEMPLATE_TRANSFER_STATE = 0x02,
+    TX_TEMPLATE_NATIVE_TAIL = 0x03,
+} tx_template_op_e;
+
+// Flag of HEADER and TRANSFER_STATE, the address is the last one sent in full
+#define TX_TEMPLATE_REPEAT_ADDRESS 0x01
+
+/**
+ * Structure for the template decoder state, kept between the APDUs of an upload.
+ */
+typedef struct {
+    uint8_t address[ADDRESS_SCRIPT_HASH_LEN];  // last payer or from sent in full
+    bool has_address;
+} tx_template_t;
+
+/**
+ * Decode template-encoded operations and append the bytes they stand for.
+ *
+ * @param[in,out] ctx
+ *   Pointer to the decoder state.
+ * @param[in,out] in
+ *   Pointer to buffer with whole encoded operations.
+ * @param[out] out
+ *   Pointer to the raw transaction.
+ * @param[in] out_size
+ *   Size of the raw transaction buffer.
+ * @param[in,out] out_len
+ *   Length of the raw transaction, only updated on success.
+ * @return true if success, false if an operation is malformed or the bytes do not fit.
+ */
+bool tx_template_decode(tx_template_t *ctx,
+                        buffer_t *in,
+                        uint8_t *out,
+                        size_t out_size,
+                        size_t *out_len);
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <stddef.h>  // size_t
-#include <stdint.h>  // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+#include "amount.h"
 
 // Number of supported simple type parameters
 #if defined(TARGET_STAX) || defined(TARGET_FLEX)
@@ -10,11 +13,20 @@
 #define PARAMETERS_MAX_NUM 90
 #endif
 
+// Number of transfer states of a native transfer, each one is reviewed as 3 pairs and the review
+// also shows the gas fee and the signer, within the 255 pairs a NBGL review can hold
+#define TRANSFER_STATES_MAX_NUM ((UINT8_MAX - 2) / 3)
+
 enum {
     GAS_PRICE_MIN = 2500,
     GAS_LIMIT_MIN = 20000,
 };
 
+// The length of the transaction header: version, tx-type, nonce, gasPrice, gasLimit and payer
+enum {
+    TX_HEADER_LEN = 42,
+};
+
 // The number of fixed-length bytes at the contract end
 enum {
     NATIVE_CONTRACT_CONSTANT_LENGTH = 47,   //native contract
@@ -22,8 +34,16 @@ enum {
 };
 
 enum {
+    OPCODE_PUSHBYTES1 = 0x01,
     OPCODE_PUSHBYTES21 = 0x21,
+    OPCODE_PUSHBYTES75 = 0x4b,
+    OPCODE_PUSHDATA1 = 0x4c,
+    OPCODE_PUSHDATA2 = 0x4d,
+    OPCODE_PUSHDATA4 = 0x4e,
     OPCODE_PUSH_NUMBER = 0x50, // PUSHN = OPCODE_PUSH_NUMBER + N, 1<=N<=16
+    OPCODE_JMP = 0x62,         // JMP, JMPIF, JMPIFNOT and CALL take a 2-byte offset
+    OPCODE_CALL = 0x65,
+    OPCODE_TAILCALL = 0x69,
     OPCODE_CHECKSIG = 0xac,
 };
 
@@ -43,11 +63,23 @@ static const uint8_t NATIVE_INVOKE[] = {0x16, 'O', 'n', 't', 'o', 'l', 'o', 'g',
  */
 typedef enum {
     PARSING_OK = 1,
+    PARSING_NEED_MORE = 0,  //more bytes must arrive before parsing can go on
     PARSING_TX_NOT_DEFINED = -2, //not found in the pre-defined contract and method list.
     PARSING_LENGTH_WRONG = -3,
     PARSING_BYTECODE_WRONG = -4,
 } parser_status_e;
 
+/**
+ * Enumeration with the stages of the resumable transaction parser.
+ */
+typedef enum {
+    TX_STAGE_HEADER,        // waiting for the 42-byte header
+    TX_STAGE_PAYLOAD_SIZE,  // waiting for the payload size
+    TX_STAGE_PAYLOAD,       // walking the payload code as it arrives
+    TX_STAGE_TAIL,          // payload received, waiting for the final chunk
+    TX_STAGE_DONE,          // transaction fully parsed
+} tx_parser_stage_e;
+
 /**
  * Enumeration with transaction contract type.
  */
@@ -73,6 +105,29 @@ typedef enum {
     PARAM_TRANSFER_STATE_LIST,  // Composite type: PARAM_TRANSFER_STATE * n
 } tx_parameter_type_e;
 
+/**
+ * Enumeration with the registered methods, resolved once from the method name at parse time.
+ */
+typedef enum {
+    METHOD_ID_UNKNOWN,  // not a registered method, only blind signing can accept it
+    METHOD_ID_TRANSFER,
+    METHOD_ID_TRANSFER_FROM,
+    METHOD_ID_APPROVE,
+    METHOD_ID_TRANSFER_V2,
+    METHOD_ID_TRANSFER_FROM_V2,
+    METHOD_ID_APPROVE_V2,
+    METHOD_ID_REGISTER_CANDIDATE,
+    METHOD_ID_QUIT_NODE,
+    METHOD_ID_ADD_INIT_POS,
+    METHOD_ID_REDUCE_INIT_POS,
+    METHOD_ID_CHANGE_MAX_AUTH,
+    METHOD_ID_SET_FEE_PERCENTAGE,
+    METHOD_ID_AUTHORIZE_FOR_PEER,
+    METHOD_ID_UNAUTHORIZE_FOR_PEER,
+    METHOD_ID_WITHDRAW,
+    METHOD_ID_WITHDRAW_FEE,
+} tx_method_id_e;
+
 /**
  * Structure for transaction header.
  */
@@ -87,13 +142,17 @@ typedef struct {
 
 /**
  * Structure for transaction parameter.
+ * Parameters always point into the raw transaction, so only their offset is kept.
+ * A parameter with a zero length has not been set.
  */
 typedef struct {
-    uint8_t *data;
-    tx_parameter_type_e type;
+    uint16_t offset;  // offset of the parameter in the raw transaction
     uint8_t len;
+    uint8_t type;     // tx_parameter_type_e
 } tx_parameter_t;
 
+_Static_assert(sizeof(tx_parameter_t) == 4, "tx_parameter_t must stay packed");
+
 /**
  * Structure for transaction contract.
  */
@@ -104,19 +163,69 @@ typedef struct {
     uint8_t token_decimals;
 } tx_contract_t;
 
+/**
+ * Structure for a repeated group of parameters (transfer states or pk/amount pairs).
+ * The parser only validates the elements, they are decoded on demand by the display.
+ * The cursor remembers the last decoded element so that walking the group in order is linear.
+ */
+typedef struct {
+    uint16_t offset;         // offset of the first element in the raw transaction
+    uint16_t end;            // offset right after the group
+    uint16_t values_offset;  // offset of the first value of a group of pairs, after the keys
+    uint16_t count;          // number of elements, zero if the method has no group
+    uint16_t cursor_index;   // index of the element at `cursor_offset`
+    uint16_t cursor_offset;  // offset of the element `cursor_index`
+    amount_t total;          // sum of the values of a group of pairs, computed by the parser
+} tx_param_group_t;
+
+/**
+ * Structure for a run of consecutive elements of a repeated group, validated while the payload
+ * arrives, before the method telling which group the payload holds is known.
+ */
+typedef struct {
+    uint16_t offset;  // offset of the first element in the raw transaction
+    uint16_t end;     // offset right after the last element validated
+    uint16_t count;   // number of elements validated, zero if there is no run
+} tx_group_run_t;
+
 /**
  * Structure for transaction method.
  */
 typedef struct {
     tx_parameter_t name;
+    tx_method_id_e id;
     tx_parameter_t parameters[PARAMETERS_MAX_NUM];  //only store simple type parameters
+    tx_param_group_t group;
+    tx_group_run_t transfer_run;  // transfer states from the start of the payload
+    tx_group_run_t pk_run;        // last run of public keys followed by 6a7cc8
 } tx_method_t;
 
 /**
  * Structure for transaction.
  */
 typedef struct {
+    const uint8_t *raw;  // raw transaction the parameters point into
     tx_header_t header;
     tx_contract_t contract;
     tx_method_t method;
 } transaction_t;
+
+// Instructions remembered before the method name push: 0x6a7cc86c for native contracts
+#define NEOVM_METHOD_PREV_NUM 4
+// The method name push is 2 instructions before SYSCALL, after the contract address and PUSH0
+#define NEOVM_RECENT_NUM (2 + 1 + NEOVM_METHOD_PREV_NUM)
+
+/**
+ * Structure for the state kept by the resumable transaction parser between chunks.
+ */
+typedef struct {
+    tx_parser_stage_e stage;
+    size_t offset;         // offset of the next unconsumed byte of the raw transaction
+    size_t payload_begin;  // offset of the first byte of the payload code
+    size_t payload_end;    // offset right after the last byte of the payload code
+    bool opaque_code;      // the payload code could not be walked, it can only be blind signed
+    size_t recent[NEOVM_RECENT_NUM];  // offsets of the last instructions walked, most recent first
+    size_t call_offset;    // offset of the last APPCALL or SYSCALL instruction walked
+    size_t method_offset;  // offset of the method name push of that call
+    size_t method_prev[NEOVM_METHOD_PREV_NUM];  // offsets of the instructions before that push
+} tx_parser_t;
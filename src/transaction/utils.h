@@ -6,10 +6,27 @@
 #include <string.h>
 
 #include "../types.h"
+#include "amount.h"
+
+/**
+ * Get the bytes of a parameter.
+ *
+ * @param[in] raw
+ *   Pointer to the raw transaction the parameter was parsed from.
+ * @param[in] param
+ *   Pointer to parameter structure.
+ *
+ * @return pointer to the first byte of the parameter.
+ */
+static inline uint8_t *param_data(const uint8_t *raw, const tx_parameter_t *param) {
+    return (uint8_t *) raw + param->offset;
+}
 
 /**
  * Convert a parameter to a uint64_t in little-endian order.
  *
+ * @param[in] raw
+ *   Pointer to the raw transaction the parameter was parsed from.
  * @param[in] amount
  *   Pointer to parameter structure containing the amount.
  *   The amount SHOULD have a length prefix!
@@ -18,12 +35,33 @@
  *
  * @return true if conversion successful, false otherwise.
  */
-bool convert_param_to_uint64_le(tx_parameter_t *amount, uint64_t *out);
+bool convert_param_to_uint64_le(const uint8_t *raw, const tx_parameter_t *amount, uint64_t *out);
+
+/**
+ * Decode an amount parameter (PARAM_AMOUNT or PARAM_UINT128).
+ *
+ * @param[in] raw
+ *   Pointer to the raw transaction the parameter was parsed from.
+ * @param[in] amount
+ *   Pointer to parameter structure containing the amount.
+ * @param[in] has_prefix
+ *   Whether the amount is a NeoVM push (PARAM_AMOUNT) or 16 raw bytes (PARAM_UINT128).
+ * @param[out] out
+ *   Pointer to the decoded amount.
+ *
+ * @return true if conversion successful, false otherwise.
+ */
+bool convert_param_to_amount(const uint8_t *raw,
+                             const tx_parameter_t *amount,
+                             bool has_prefix,
+                             amount_t *out);
 
 /**
  * Convert a parameter amount (including PARAM_UINT128 and PARAM_AMOUNT) to a 
  * decimal string representation.
  *
+ * @param[in] raw
+ *   Pointer to the raw transaction the parameter was parsed from.
  * @param[in] param
  *   Pointer to parameter structure containing the amount.
  * @param[in] decimals
@@ -37,26 +75,13 @@ bool convert_param_to_uint64_le(tx_parameter_t *amount, uint64_t *out);
  *
  * @return true if conversion successful, false otherwise.
  */
-bool convert_param_amount_to_chars(tx_parameter_t *param,
+bool convert_param_amount_to_chars(const uint8_t *raw,
+                                   const tx_parameter_t *param,
                                    uint8_t decimals,
                                    bool has_prefix,
                                    char *amount,
                                    size_t amount_len);
 
-/**
- * Compare a parameter's method name against a string.
- *
- * @param[in] param
- *   Pointer to parameter structure containing the method name.
- * @param[in] method_name
- *   String to compare against.
- *
- * @return true if method names match, false otherwise.
- */
-static inline bool methodcmp(const tx_parameter_t *param, const char *method_name) {
-    return param->len == strlen(method_name) && memcmp(param->data, method_name, param->len) == 0;
-}
-
 /**
  * Validate a BIP-32 path prefix (44'/1024' or 44'/888').
  *
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include "wasm.h"
+#include "address.h"
+
+#if defined(TEST) || defined(FUZZ)
+#include "assert.h"
+#define LEDGER_ASSERT(x, y) assert(x)
+#else
+#include "ledger_assert.h"
+#endif
+
+#define WASM_U128_LEN 16
+
+bool wasm_read_varuint(buffer_t *buf, uint64_t *out) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+
+    uint8_t prefix = 0;
+    if (!buffer_read_u8(buf, &prefix)) {
+        return false;
+    }
+
+    uint64_t min = 0;
+    if (prefix < 0xfd) {
+        *out = prefix;
+        return true;
+    } else if (prefix == 0xfd) {
+        uint16_t n = 0;
+        if (!buffer_read_u16(buf, &n, LE)) {
+            return false;
+        }
+        *out = n;
+        min = 0xfd;
+    } else if (prefix == 0xfe) {
+        uint32_t n = 0;
+        if (!buffer_read_u32(buf, &n, LE)) {
+            return false;
+        }
+        *out = n;
+        min = UINT16_MAX + 1ULL;
+    } else {
+        if (!buffer_read_u64(buf, out, LE)) {
+            return false;
+        }
+        min = UINT32_MAX + 1ULL;
+    }
+    // ZeroCopySource rejects the encodings which are not the shortest
+    return *out >= min;
+}
+
+bool wasm_read_bytes(buffer_t *buf, size_t max_len, tx_parameter_t *out) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+    LEDGER_ASSERT(max_len <= UINT8_MAX, "max_len too large");
+
+    uint64_t len = 0;
+    if (!wasm_read_varuint(buf, &len) || len > max_len || !buffer_can_read(buf, (size_t) len)) {
+        return false;
+    }
+
+    out->len = (uint8_t) len;
+    out->offset = (uint16_t) buf->offset;
+    return buffer_seek_cur(buf, (size_t) len);
+}
+
+bool wasm_read_address(buffer_t *buf, tx_parameter_t *out) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+
+    if (!buffer_can_read(buf, ADDRESS_SCRIPT_HASH_LEN)) {
+        return false;
+    }
+
+    out->len = ADDRESS_SCRIPT_HASH_LEN;
+    out->offset = (uint16_t) buf->offset;
+    out->type = PARAM_ADDR;
+    return buffer_seek_cur(buf, ADDRESS_SCRIPT_HASH_LEN);
+}
+
+bool wasm_read_u128(buffer_t *buf, tx_parameter_t *out) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+
+    if (!buffer_can_read(buf, WASM_U128_LEN)) {
+        return false;
+    }
+
+    out->len = WASM_U128_LEN;
+    out->offset = (uint16_t) buf->offset;
+    out->type = PARAM_UINT128;
+    return buffer_seek_cur(buf, WASM_U128_LEN);
+}
+
+bool wasm_read_bool(buffer_t *buf, bool *out) {
+    LEDGER_ASSERT(buf != NULL, "NULL buf");
+    LEDGER_ASSERT(out != NULL, "NULL out");
+
+    uint8_t value = 0;
+    if (!buffer_read_u8(buf, &value) || value > 1) {
+        return false;
+    }
+    *out = value == 1;
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+
+#include "buffer.h"
+#include "tx_types.h"
+
+/*
+ * Decoder of the arguments of a WASM VM invocation, serialized like Ontology's ZeroCopySink:
+ * - varuint: 1 byte below 0xfd, else 0xfd, 0xfe or 0xff followed by a 2, 4 or 8-byte little
+ *   endian integer. The shortest encoding must be used.
+ * - bytes and string: varuint length followed by the bytes.
+ * - address: 20 bytes.
+ * - u128: 16 bytes, little endian.
+ * - bool: 1 byte, 0 or 1.
+ * The parameters filled by these functions point to the decoded bytes in the buffer.
+ */
+
+/**
+ * Read a varuint.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized arguments.
+ * @param[out] out
+ *   Pointer to the decoded value.
+ * @return true if success, false otherwise.
+ */
+bool wasm_read_varuint(buffer_t *buf, uint64_t *out);
+
+/**
+ * Read a byte array or a string, prefixed with its varuint length.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized arguments.
+ * @param[in] max_len
+ *   Maximum length of the bytes, at most UINT8_MAX.
+ * @param[out] out
+ *   Parameter pointing to the bytes.
+ * @return true if success, false otherwise.
+ */
+bool wasm_read_bytes(buffer_t *buf, size_t max_len, tx_parameter_t *out);
+
+/**
+ * Read an address.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized arguments.
+ * @param[out] out
+ *   Parameter pointing to the address.
+ * @return true if success, false otherwise.
+ */
+bool wasm_read_address(buffer_t *buf, tx_parameter_t *out);
+
+/**
+ * Read a 128-bit unsigned integer.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized arguments.
+ * @param[out] out
+ *   Parameter pointing to the integer.
+ * @return true if success, false otherwise.
+ */
+bool wasm_read_u128(buffer_t *buf, tx_parameter_t *out);
+
+/**
+ * Read a boolean.
+ *
+ * @param[in,out] buf
+ *   Pointer to buffer with the serialized arguments.
+ * @param[out] out
+ *   Pointer to the decoded value.
+ * @return true if success, false otherwise.
+ */
+bool wasm_read_bool(buffer_t *buf, bool *out);
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <string.h>  // memcpy, memmove, explicit_bzero
+
+#include "os.h"
+#include "ledger_assert.h"
+
+#include "tx_queue.h"
+#include "globals.h"
+#include "sw.h"
+#include "display.h"
+
+void tx_queue_push_result(uint16_t sw) {
+    // The uploads are refused once TX_QUEUE_MAX_NUM results are pending
+    LEDGER_ASSERT(G_tx_queue.results_num < TX_QUEUE_MAX_NUM, "Too many results");
+
+    tx_result_t *result = &G_tx_queue.results[G_tx_queue.results_num++];
+    explicit_bzero(result, sizeof(*result));
+    result->sw = sw;
+    if (sw == SW_OK) {
+        memcpy(result->signature, G_context.tx_info.signature, G_context.tx_info.signature_len);
+        result->signature_len = G_context.tx_info.signature_len;
+        result->v = G_context.tx_info.v;
+    }
+    G_tx_queue.reviewing = false;
+}
+
+#ifdef TX_QUEUE_STAGING
+bool tx_queue_review_staged(void) {
+    if (!G_tx_queue.staged_ready) {
+        return false;
+    }
+
+    explicit_bzero(&G_context, sizeof(G_context));
+    memcpy(&G_context.tx_info, &G_tx_queue.staged, sizeof(G_context.tx_info));
+    memcpy(G_context.bip32_path, G_tx_queue.bip32_path, sizeof(G_context.bip32_path));
+    G_context.bip32_path_len = G_tx_queue.bip32_path_len;
+    memcpy(G_context.signer_address,
+           G_tx_queue.signer_address,
+           sizeof(G_context.signer_address));
+
+    // The parsed transaction points into the raw transaction it was parsed from
+    transaction_t *tx = &G_context.tx_info.transaction;
+    tx->raw = G_context.tx_info.raw_tx;
+    if (tx->header.payer != NULL) {
+        tx->header.payer = G_context.tx_info.raw_tx + (tx->header.payer - G_tx_queue.staged.raw_tx);
+    }
+
+    const bool is_blind = G_tx_queue.staged_blind;
+    explicit_bzero(&G_tx_queue.staged, sizeof(G_tx_queue.staged));
+    G_tx_queue.staged_ready = false;
+    G_tx_queue.staged_blind = false;
+
+    G_context.req_type = CONFIRM_TRANSACTION;
+    G_context.state = STATE_PARSED;
+    G_tx_queue.reviewing = true;
+    uint16_t sw = ui_review_transaction(is_blind);
+    if (sw != SW_OK) {
+        G_context.state = STATE_NONE;
+        tx_queue_push_result(sw);
+        return false;
+    }
+    return true;
+}
+
+void tx_queue_drop_staging(void) {
+    G_tx_queue.staging = false;
+    explicit_bzero(&G_tx_queue.staged, sizeof(G_tx_queue.staged));
+    explicit_bzero(G_tx_queue.bip32_path, sizeof(G_tx_queue.bip32_path));
+    G_tx_queue.bip32_path_len = 0;
+    explicit_bzero(G_tx_queue.signer_address, sizeof(G_tx_queue.signer_address));
+}
+#else
+bool tx_queue_review_staged(void) {
+    return false;
+}
+
+void tx_queue_drop_staging(void) {
+    G_tx_queue.staging = false;
+}
+#endif
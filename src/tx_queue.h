@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+/**
+ * @brief Keeps the result of the queued review of G_context.tx_info, to be read with
+ * SIGN_TX_RESULT.
+ *
+ * @param[in] sw SW_OK if the transaction was signed, the status word of the failure otherwise.
+ */
+void tx_queue_push_result(uint16_t sw);
+
+/**
+ * @brief Moves the transaction of the staging slot to G_context and starts its review.
+ *
+ * A review which cannot be displayed is answered with its status word like a refused one.
+ *
+ * @return true if a review is displayed, false if there was no staged transaction or the
+ * review failed.
+ */
+bool tx_queue_review_staged(void);
+
+/**
+ * @brief Drops the upload in progress into the staging slot, the next one starts again from
+ * its first chunk.
+ */
+void tx_queue_drop_staging(void);
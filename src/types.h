@@ -1,7 +1,8 @@
 #pragma once
 
-#include <stddef.h>  // size_t
-#include <stdint.h>  // uint*_t
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
 
 #include "bip32.h"
 #include "lcx_sha256.h"
@@ -9,16 +10,23 @@
 #include "constants.h"
 #include "tx_types.h"
 #include "address.h"
+#include "batch.h"
+#include "template.h"
 
 /**
  * Enumeration with expected INS of APDU commands.
  */
 typedef enum {
-    SIGN_TX = 0x02,         /// sign transaction with BIP32 path
-    GET_VERSION = 0x03,     /// version of the application
-    GET_PUBLIC_KEY = 0x04,  /// public key of corresponding BIP32 path
-    GET_APP_NAME = 0x05,    /// name of the application
-    SIGN_MESSAGE = 0x07,    /// sign personal message
+    SIGN_TX = 0x02,          /// sign transaction with BIP32 path
+    GET_VERSION = 0x03,      /// version of the application
+    GET_PUBLIC_KEY = 0x04,   /// public key of corresponding BIP32 path
+    GET_APP_NAME = 0x05,     /// name of the application
+    SIGN_MESSAGE = 0x07,     /// sign personal message
+    GET_PUBLIC_KEYS = 0x08,  /// public keys of a range of indices below a BIP32 path
+    SIGN_TX_BATCH = 0x09,    /// sign a batch of transfers with BIP32 path
+    SIGN_TX_RESULT = 0x0A,   /// result of the oldest queued transaction review
+    OPEN_SESSION = 0x0B,     /// pin a BIP32 path for the following signing requests
+    CLOSE_SESSION = 0x0C,    /// forget the pinned BIP32 path
 } command_e;
 /**
  * Enumeration with parsing state.
@@ -35,9 +43,20 @@ typedef enum {
 typedef enum {
     CONFIRM_ADDRESS,      /// confirm address derived from public key
     CONFIRM_TRANSACTION,  /// confirm transaction information
-    CONFIRM_MESSAGE       /// confirm message information
+    CONFIRM_MESSAGE,      /// confirm message information
+    CONFIRM_BATCH         /// confirm summary of a batch of transactions
 } request_type_e;
 
+/**
+ * Enumeration with the response formats of GET_PUBLIC_KEY, in P2.
+ */
+typedef enum {
+    PUBKEY_FORMAT_UNCOMPRESSED = 0x00,  /// uncompressed public key and chain code
+    PUBKEY_FORMAT_COMPRESSED = 0x01,    /// compressed public key
+    PUBKEY_FORMAT_SCRIPT_HASH = 0x02,   /// script hash of the address
+    PUBKEY_FORMAT_ADDRESS = 0x03,       /// base58 address
+} pubkey_format_e;
+
 /**
  * Structure for public key context information.
  */
@@ -45,6 +64,7 @@ typedef struct {
     uint8_t
         raw_public_key[UNCOMPRESSED_KEY_LEN];  /// format (1), x-coordinate (32), y-coodinate (32)
     uint8_t chain_code[CHAIN_CODE_LEN];        /// for public key derivation
+    pubkey_format_e format;                    /// format of the response
 } pubkey_ctx_t;
 
 /**
@@ -54,6 +74,9 @@ typedef struct {
     uint8_t raw_tx[MAX_TRANSACTION_LEN];   /// raw transaction serialized
     size_t raw_tx_len;                     /// length of raw transaction
     transaction_t transaction;             /// structured transaction
+    tx_parser_t parser;                    /// resumable parser state, kept between chunks
+    cx_sha256_t hash_ctx;                  /// running SHA-256 of raw_tx, updated per chunk
+    tx_template_t template_ctx;            /// template decoder state, kept between chunks
     uint8_t m_hash[CX_SHA256_SIZE];        /// message hash digest
     uint8_t signature[MAX_SIGNATURE_LEN];  /// transaction signature encoded in DER
     uint8_t signature_len;                 /// length of transaction signature
@@ -72,6 +95,81 @@ typedef struct {
     uint8_t v;                             /// parity of y-coordinate of R in ECDSA signature
 } message_ctx_t;
 
+/**
+ * Structure for the signing session, whose path is used by the requests sent without one.
+ */
+typedef struct {
+    bool open;                                            /// a path is pinned
+    uint32_t bip32_path[MAX_BIP32_PATH];                  /// BIP32 path, validated
+    uint8_t bip32_path_len;                               /// length of BIP32 path
+    char signer_address[BASE58_ADDRESS_LEN + 1];          /// address of BIP32 path, derived with it
+    uint8_t signer_script_hash[ADDRESS_SCRIPT_HASH_LEN];  /// script hash of that address
+} session_ctx_t;
+
+// The staging slot is a second transaction context, only the devices with more RAM keep one
+#if defined(TARGET_STAX) || defined(TARGET_FLEX)
+#define TX_QUEUE_STAGING
+#endif
+
+// Number of queued transactions whose result has not been read, reviewed or staged
+#ifdef TX_QUEUE_STAGING
+#define TX_QUEUE_MAX_NUM 2
+#else
+#define TX_QUEUE_MAX_NUM 1
+#endif
+
+/**
+ * Structure for the result of a queued transaction review.
+ */
+typedef struct {
+    uint16_t sw;                           /// SW_OK if signed, status word of the failure otherwise
+    uint8_t signature[MAX_SIGNATURE_LEN];  /// transaction signature encoded in DER
+    uint8_t signature_len;                 /// length of transaction signature
+    uint8_t v;                             /// parity of y-coordinate of R in ECDSA signature
+} tx_result_t;
+
+/**
+ * Structure for the queued transactions, whose SIGN_TX upload is answered before the review.
+ * With TX_QUEUE_STAGING, the next transaction is received into the staging slot while the
+ * current one is reviewed, and goes to review as soon as the user answers.
+ */
+typedef struct {
+#ifdef TX_QUEUE_STAGING
+    transaction_ctx_t staged;                     /// staging slot, the signature is unused
+    uint32_t bip32_path[MAX_BIP32_PATH];          /// BIP32 path of the staged transaction
+    uint8_t bip32_path_len;                       /// length of its BIP32 path
+    char signer_address[BASE58_ADDRESS_LEN + 1];  /// address of its BIP32 path
+#endif
+    bool staging;                                 /// the current upload goes to the slot
+    bool staged_ready;                            /// the slot holds a parsed transaction
+    bool staged_blind;                            /// the staged transaction is blind signed
+    bool reviewing;                               /// the displayed review is a queued one
+    uint8_t pending_num;                          /// queued transactions whose result is unread
+    uint8_t results_num;                          /// results not read yet, oldest first
+    tx_result_t results[TX_QUEUE_MAX_NUM];
+} tx_queue_ctx_t;
+
+/**
+ * Structure for the signatures of a batch, computed once the batch is approved.
+ */
+typedef struct {
+    uint8_t signature[BATCH_TX_MAX_NUM][MAX_SIGNATURE_LEN];  /// signatures encoded in DER
+    uint8_t signature_len[BATCH_TX_MAX_NUM];                 /// length of each signature
+    uint8_t v[BATCH_TX_MAX_NUM];                             /// parity of y-coordinate of R
+} batch_sig_ctx_t;
+
+/**
+ * Structure for the transactions of a batch, each of them is parsed in turn in tx_info.
+ */
+typedef struct {
+    tx_batch_t summary;                                /// what the review displays
+    uint8_t m_hash[BATCH_TX_MAX_NUM][CX_SHA256_SIZE];  /// message hash digest of each transaction
+    union {
+        transaction_ctx_t tx_info;  /// transaction being received
+        batch_sig_ctx_t sig;        /// signatures, replace tx_info once approved
+    };
+} batch_ctx_t;
+
 /**
  * Structure for global context.
  */
@@ -81,8 +179,10 @@ typedef struct {
         pubkey_ctx_t pk_info;       /// public key context
         transaction_ctx_t tx_info;  /// transaction context
         message_ctx_t msg_info;     /// personal msg context
+        batch_ctx_t batch_info;     /// batch of transactions context
     };
-    request_type_e req_type;              /// user request
-    uint32_t bip32_path[MAX_BIP32_PATH];  /// BIP32 path
-    uint8_t bip32_path_len;               /// length of BIP32 path
+    request_type_e req_type;                      /// user request
+    uint32_t bip32_path[MAX_BIP32_PATH];          /// BIP32 path
+    uint8_t bip32_path_len;                       /// length of BIP32 path
+    char signer_address[BASE58_ADDRESS_LEN + 1];  /// address of BIP32 path, derived with it
 } global_ctx_t;
@@ -16,6 +16,7 @@
  *****************************************************************************/
 
 #include <stdbool.h>  // bool
+#include <string.h>   // explicit_bzero
 
 #include "crypto_helpers.h"
 
@@ -24,6 +25,7 @@
 #include "sw.h"
 #include "globals.h"
 #include "send_response.h"
+#include "../../tx_queue.h"
 
 void validate_pubkey(bool choice) {
     if (choice) {
@@ -58,18 +60,23 @@ static int crypto_sign_tx(void) {
 }
 
 void validate_transaction(bool choice) {
+    uint16_t sw = SW_DENY;
+
     if (choice) {
         G_context.state = STATE_APPROVED;
+        sw = crypto_sign_tx() != 0 ? SW_SIGNATURE_FAIL : SW_OK;
+    }
+    if (sw != SW_OK) {
+        G_context.state = STATE_NONE;
+    }
 
-        if (crypto_sign_tx() != 0) {
-            G_context.state = STATE_NONE;
-            io_send_sw(SW_SIGNATURE_FAIL);
-        } else {
-            helper_tx_send_response_sig();
-        }
+    if (G_tx_queue.reviewing) {
+        // The upload has already been answered, the result is read with SIGN_TX_RESULT
+        tx_queue_push_result(sw);
+    } else if (sw == SW_OK) {
+        helper_tx_send_response_sig();
     } else {
-        G_context.state = STATE_NONE;
-        io_send_sw(SW_DENY);
+        io_send_sw(sw);
     }
     ui_menu_main();
 }
@@ -112,4 +119,49 @@ void validate_personal_msg(bool choice) {
         G_context.state = STATE_NONE;
         io_send_sw(SW_DENY);
     }
-}
\ No newline at end of file
+}
+
+static int crypto_sign_batch(void) {
+    cx_ecfp_256_private_key_t private_key;
+
+    // The key is derived once and signs every transaction of the batch
+    cx_err_t error = bip32_derive_init_privkey_256(CX_CURVE_256R1,
+                                                   G_context.bip32_path,
+                                                   G_context.bip32_path_len,
+                                                   &private_key,
+                                                   NULL);
+    for (uint8_t i = 0; error == CX_OK && i < G_context.batch_info.summary.tx_count; i++) {
+        uint32_t info = 0;
+        size_t sig_len = sizeof(G_context.batch_info.sig.signature[i]);
+
+        error = cx_ecdsa_sign_no_throw((const cx_ecfp_private_key_t *) &private_key,
+                                       CX_RND_RFC6979 | CX_LAST,
+                                       CX_SHA256,
+                                       G_context.batch_info.m_hash[i],
+                                       sizeof(G_context.batch_info.m_hash[i]),
+                                       G_context.batch_info.sig.signature[i],
+                                       &sig_len,
+                                       &info);
+        G_context.batch_info.sig.signature_len[i] = (uint8_t) sig_len;
+        G_context.batch_info.sig.v[i] = (uint8_t) (info & CX_ECCINFO_PARITY_ODD);
+    }
+    explicit_bzero(&private_key, sizeof(private_key));
+
+    return error == CX_OK ? 0 : -1;
+}
+
+void validate_batch(bool choice) {
+    if (choice) {
+        G_context.state = STATE_APPROVED;
+
+        if (crypto_sign_batch() != 0) {
+            G_context.state = STATE_NONE;
+            io_send_sw(SW_SIGNATURE_FAIL);
+        } else {
+            helper_batch_send_response_sig(0);
+        }
+    } else {
+        G_context.state = STATE_NONE;
+        io_send_sw(SW_DENY);
+    }
+}
@@ -27,3 +27,11 @@ void validate_transaction(bool choice);
  *
  */
  void validate_personal_msg(bool choice);
+/**
+ * Action for the validation of the summary of a batch of transactions.
+ *
+ * @param[in] choice
+ *   User choice (either approved or rejected).
+ *
+ */
+void validate_batch(bool choice);
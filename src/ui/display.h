@@ -44,6 +44,15 @@ int ui_display_address(void);
  *
  */
 int ui_display_transaction(bool is_blind_signed);
+
+/**
+ * Start the review of the transaction of G_context.tx_info, without sending any APDU response
+ * on failure. Used for the queued transactions, whose upload has already been answered.
+ *
+ * @return SW_OK if the review is displayed, the status word of the failure otherwise.
+ *
+ */
+uint16_t ui_review_transaction(bool is_blind_signed);
 /**
  * Display personal msg information on the device and ask confirmation to sign.
  *
@@ -51,6 +60,11 @@ int ui_display_transaction(bool is_blind_signed);
  *
  */
 int ui_display_message(void);
-
-
-
+/**
+ * Display the summary of a batch of transactions on the device and ask confirmation to sign
+ * all of them.
+ *
+ * @return 0 if success, negative integer otherwise.
+ *
+ */
+int ui_display_batch(void);
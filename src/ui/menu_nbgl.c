@@ -17,6 +17,8 @@
 
 #ifdef HAVE_NBGL
 
+#include <string.h>  // explicit_bzero
+
 #include "os.h"
 #include "glyphs.h"
 #include "nbgl_use_case.h"
@@ -25,6 +27,7 @@
 #include "menu.h"
 #include "display.h"
 #include "types.h"
+#include "../pubkey_cache.h"
 
 //  -----------------------------------------------------------
 //  ----------------------- HOME PAGE -------------------------
@@ -32,6 +35,8 @@
 
 void app_quit(void) {
     // exit app here
+    pubkey_cache_clear();
+    explicit_bzero(&G_session, sizeof(G_session));
     os_sched_exit(-1);
 }
 
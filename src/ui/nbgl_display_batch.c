@@ -0,0 +1,140 @@
+/*****************************************************************************
+ *   Ontology Ledger App
+ *   (c) 2025 Ontology
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+#ifdef HAVE_NBGL
+
+#include <stdbool.h>  // bool
+#include <string.h>   // explicit_bzero
+
+#include "os.h"
+#include "glyphs.h"
+#include "nbgl_use_case.h"
+#include "io.h"
+#include "format.h"
+
+#include "display.h"
+#include "constants.h"
+#include "globals.h"
+#include "sw.h"
+#include "validate.h"
+#include "menu.h"
+#include "types.h"
+#include "address.h"
+#include "../transaction/amount.h"
+#include "../transaction/batch.h"
+#include "../transaction/contract.h"
+#include "../transaction/utils.h"
+
+static void batch_review_choice(bool confirm) {
+    validate_batch(confirm);
+    nbgl_useCaseReviewStatus(
+        confirm ? STATUS_TYPE_TRANSACTION_SIGNED : STATUS_TYPE_TRANSACTION_REJECTED,
+        ui_menu_main);
+}
+
+static bool total_to_chars(const amount_t *total,
+                           uint8_t decimals,
+                           const char *ticker,
+                           char *out,
+                           size_t out_len) {
+    if (!amount_to_chars(total, decimals, out, out_len)) {
+        return false;
+    }
+    strlcat(out, " ", out_len);
+    strlcat(out, ticker, out_len);
+    return true;
+}
+
+// g_buffers[0]: number of transactions
+// g_buffers[(1 + i) * MAX_BUFFER_LEN]: total of the token i
+// g_buffers[(1 + BATCH_TOKENS_MAX_NUM) * MAX_BUFFER_LEN]: total gas fee
+// g_buffers[(2 + BATCH_TOKENS_MAX_NUM) * MAX_BUFFER_LEN]: number of recipients
+// g_buffers[(3 + BATCH_TOKENS_MAX_NUM + i) * MAX_BUFFER_LEN]: address of the recipient i
+_Static_assert(3 + BATCH_TOKENS_MAX_NUM + BATCH_RECIPIENTS_MAX_NUM + 1 <= NUM_PAIRS,
+               "batch review pairs");
+
+int ui_display_batch(void) {
+    if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_PARSED) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    const tx_batch_t *summary = &G_context.batch_info.summary;
+    char *gas = &g_buffers[(1 + BATCH_TOKENS_MAX_NUM) * MAX_BUFFER_LEN];
+    char *recipients = &g_buffers[(2 + BATCH_TOKENS_MAX_NUM) * MAX_BUFFER_LEN];
+
+    explicit_bzero(g_pairs, sizeof(g_pairs));
+    explicit_bzero(g_buffers, sizeof(g_buffers));
+    explicit_bzero(&g_pairList, sizeof(g_pairList));
+    g_pairList.pairs = g_pairs;
+    g_pairList.nbPairs = 0;
+
+    format_u64(g_buffers, MAX_BUFFER_LEN, summary->tx_count);
+    g_pairs[g_pairList.nbPairs].item = BATCH_TX_COUNT;
+    g_pairs[g_pairList.nbPairs++].value = g_buffers;
+
+    for (uint8_t i = 0; i < summary->tokens_num; i++) {
+        char *total = &g_buffers[(1 + i) * MAX_BUFFER_LEN];
+        if (!total_to_chars(&summary->tokens[i].total,
+                            summary->tokens[i].decimals,
+                            summary->tokens[i].ticker,
+                            total,
+                            MAX_BUFFER_LEN)) {
+            return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+        }
+        g_pairs[g_pairList.nbPairs].item = BATCH_TOTAL_AMOUNT;
+        g_pairs[g_pairList.nbPairs++].value = total;
+    }
+
+    if (!total_to_chars(&summary->gas, ONG_DECIMALS, ONG_TICKER, gas, MAX_BUFFER_LEN)) {
+        return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+    }
+    g_pairs[g_pairList.nbPairs].item = BATCH_TOTAL_GAS;
+    g_pairs[g_pairList.nbPairs++].value = gas;
+
+    format_u64(recipients, MAX_BUFFER_LEN, summary->recipients_num);
+    g_pairs[g_pairList.nbPairs].item = BATCH_RECIPIENTS;
+    g_pairs[g_pairList.nbPairs++].value = recipients;
+
+    for (uint8_t i = 0; i < summary->recipients_num; i++) {
+        char *address = &g_buffers[(3 + BATCH_TOKENS_MAX_NUM + i) * MAX_BUFFER_LEN];
+        if (!convert_script_hash_to_base58_address(address,
+                                                   MAX_BUFFER_LEN,
+                                                   summary->recipients[i])) {
+            return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        }
+        g_pairs[g_pairList.nbPairs].item = TO;
+        g_pairs[g_pairList.nbPairs++].value = address;
+    }
+
+    g_pairs[g_pairList.nbPairs].item = SIGNER;
+    g_pairs[g_pairList.nbPairs++].value = G_context.signer_address;
+
+    nbgl_useCaseReview(TYPE_TRANSACTION,
+                       &g_pairList,
+                       &ICON_APP_ONTOLOGY,
+                       BATCH_TITLE,
+                       NULL,
+#ifdef SCREEN_SIZE_WALLET
+                       BATCH_CONTENT,
+#else
+                       NULL,
+#endif
+                       batch_review_choice);
+    return 0;
+}
+
+#endif
@@ -125,9 +125,6 @@ int ui_display_message() {
     explicit_bzero(g_buffers, sizeof(g_buffers));
 
     const size_t pos = sizeof(g_buffers) - MAX_BUFFER_LEN;
-    if (!derive_address_from_bip32_path(&g_buffers[pos], MAX_BUFFER_LEN)) {
-        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
-    }
 
     const size_t msg_len = G_context.msg_info.raw_msg_len;
     const uint8_t *msg = G_context.msg_info.raw_msg;
@@ -143,7 +140,7 @@ int ui_display_message() {
     g_pairs[g_pairList.nbPairs++].value = g_buffers;
 
     g_pairs[g_pairList.nbPairs].item = SIGNER;
-    g_pairs[g_pairList.nbPairs++].value = &g_buffers[(PARAMETERS_MAX_NUM + 1) * MAX_BUFFER_LEN];
+    g_pairs[g_pairList.nbPairs++].value = G_context.signer_address;
 
     nbgl_useCaseReview(TYPE_MESSAGE,
                        &g_pairList,
@@ -39,18 +39,54 @@
 #include "types.h"
 #include "../transaction/contract.h"
 #include "../transaction/utils.h"
+#include "../transaction/amount.h"
+#include "../transaction/parse.h"
 #include "tx_init.h"
+#include "../tx_queue.h"
 
 #define MAX_PUBKEY_DISPLAY 3 //must be smaller than UINT8_MAX
 #define AMOUNT_SIZE        50
 
 // g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN]: total amount
 // g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN + AMOUNT_SIZE]: gas fee
-// g_buffers[(PARAMETERS_MAX_NUM + 1)* MAX_BUFFER_LEN]: signer
+// The signer is G_context.signer_address, derived with the BIP32 path
 char g_buffers[NUM_PAIRS * MAX_BUFFER_LEN];
 nbgl_contentTagValue_t g_pairs[NUM_PAIRS];
 nbgl_contentTagValueList_t g_pairList;
 
+// The transfer states of a native transfer are decoded when their page is displayed.
+// Their pairs come before the ones of g_pairs and their values use the first
+// LAZY_PAIRS_NUM slots of g_buffers, which a native transfer does not use otherwise.
+#define LAZY_PAIRS_NUM 8  // must be more than the number of pairs displayed on a page
+static nbgl_contentTagValue_t g_lazy_pairs[LAZY_PAIRS_NUM];
+static uint8_t g_lazy_pairs_num;
+static const param_config_t *g_lazy_configs;
+
+static nbgl_contentTagValue_t *get_tag_value_pair(uint8_t index) {
+    if (index >= g_lazy_pairs_num) {
+        return &g_pairs[index - g_lazy_pairs_num];
+    }
+
+    transaction_t *tx = &G_context.tx_info.transaction;
+    nbgl_contentTagValue_t *pair = &g_lazy_pairs[index % LAZY_PAIRS_NUM];
+    char *value = &g_buffers[(index % LAZY_PAIRS_NUM) * MAX_BUFFER_LEN];
+    tx_parameter_t transfer_state[3];
+
+    // The parameter i of a transfer state is displayed at the position configs[i].pos
+    uint8_t i = 0;
+    while (i < 2 && g_lazy_configs[i].pos != index % 3) {
+        i++;
+    }
+    pair->item = g_lazy_configs[i].item;
+    pair->value = value;
+    // The transfer states were validated by the parser, decoding them again cannot fail
+    if (!parse_transfer_state_at(tx, index / 3, transfer_state) ||
+        !convert_tx_param_to_chars(tx, &transfer_state[i], value, MAX_BUFFER_LEN)) {
+        explicit_bzero(value, MAX_BUFFER_LEN);
+    }
+    return pair;
+}
+
 
 // Unified parameters handler function
 static bool handle_params(transaction_t *tx,
@@ -64,6 +100,21 @@ static bool handle_params(transaction_t *tx,
     }
 
     const param_config_t *configs = method->configs;
+
+    // The transfer/transferV2 methods for native tokens can involve multi-to-multi operations,
+    // meaning there can be a series of 'from', 'to', and 'amount' fields. They are not stored by
+    // the parser and are decoded on demand by `get_tag_value_pair`.
+    if (tx->contract.type == NATIVE_CONTRACT &&
+        (tx->method.id == METHOD_ID_TRANSFER || tx->method.id == METHOD_ID_TRANSFER_V2)) {
+        if (tx->method.group.count == 0 || tx->method.group.count > TRANSFER_STATES_MAX_NUM) {
+            return false;
+        }
+        g_lazy_configs = configs;
+        g_lazy_pairs_num = (uint8_t) (3 * tx->method.group.count);
+        *nbPairs = 0;
+        return true;
+    }
+
     *nbPairs = method->config_count;
     for (uint8_t i = 0; i < *nbPairs; i++) {
         if (!convert_param_to_chars(tx, i, &g_buffers[i * MAX_BUFFER_LEN], MAX_BUFFER_LEN)) {
@@ -79,7 +130,7 @@ static bool handle_params(transaction_t *tx,
     }
 
     // When registering a candidate node, the staking fee of 500 NG needs to be displayed
-    if (methodcmp(&tx->method.name, METHOD_REGISTER_CANDIDATE)) {
+    if (tx->method.id == METHOD_ID_REGISTER_CANDIDATE) {
         tag_pairs[*nbPairs].item = STAKE_FEE;
         tag_pairs[*nbPairs].value = STAKE_FEE_ONG;
         (*nbPairs)++;
@@ -88,24 +139,24 @@ static bool handle_params(transaction_t *tx,
     // The parameters of these three methods of the governance contract are of the pk_num_list type.
     // Only the first three public keys and the total amount are displayed.
     // If there are more than three public keys, the number of remaining public keys is displayed.
-    if (methodcmp(&tx->method.name, METHOD_AUTHORIZE_FOR_PEER) ||
-        methodcmp(&tx->method.name, METHOD_UNAUTHORIZE_FOR_PEER) ||
-        methodcmp(&tx->method.name, METHOD_WITHDRAW)) {
-        uint64_t pubkey_num = 0;
-        if (!convert_param_to_uint64_le(&tx->method.parameters[1], &pubkey_num) ||
-            pubkey_num == 0) {
+    if (tx->method.id == METHOD_ID_AUTHORIZE_FOR_PEER ||
+        tx->method.id == METHOD_ID_UNAUTHORIZE_FOR_PEER || tx->method.id == METHOD_ID_WITHDRAW) {
+        uint64_t pubkey_num = tx->method.group.count;
+        if (pubkey_num == 0) {
             return false;
         }
+        tx_parameter_t pk;
+        tx_parameter_t amount_param;
 
         const char *amout_item = NULL;
         const char *total_amount_item;
-        if (methodcmp(&tx->method.name, METHOD_AUTHORIZE_FOR_PEER)) {
+        if (tx->method.id == METHOD_ID_AUTHORIZE_FOR_PEER) {
             amout_item = STAKE_AMOUNT;
             total_amount_item = TOTAL_PLUS STAKE_AMOUNT;
-        } else if (methodcmp(&tx->method.name, METHOD_UNAUTHORIZE_FOR_PEER)) {
+        } else if (tx->method.id == METHOD_ID_UNAUTHORIZE_FOR_PEER) {
             amout_item = UNSTAKE_AMOUNT;
             total_amount_item = TOTAL_PLUS UNSTAKE_AMOUNT;
-        } else if (methodcmp(&tx->method.name, METHOD_WITHDRAW)) {
+        } else if (tx->method.id == METHOD_ID_WITHDRAW) {
             amout_item = WITHDRAW_AMOUNT;
             total_amount_item = TOTAL_PLUS WITHDRAW_AMOUNT;
         }
@@ -113,6 +164,9 @@ static bool handle_params(transaction_t *tx,
         size_t curr = *nbPairs;
         uint8_t max_display_num = (pubkey_num < MAX_PUBKEY_DISPLAY) ? (uint8_t)pubkey_num : MAX_PUBKEY_DISPLAY;
         for (uint8_t i = 0; i < max_display_num; i++) {
+            if (!parse_pk_amount_pair_at(tx, i, &pk, &amount_param)) {
+                return false;
+            }
             const char *label_pk;
             if (i == 0 && pubkey_num == 1) {
                 label_pk = PEER_PUBKEY;
@@ -124,10 +178,10 @@ static bool handle_params(transaction_t *tx,
                          i + 1);
                 label_pk = &g_buffers[(curr++) * MAX_BUFFER_LEN];
             }
-            if (!convert_param_to_chars(tx,
-                                        i + 2,
-                                        &g_buffers[curr * MAX_BUFFER_LEN],
-                                        MAX_BUFFER_LEN)) {
+            if (!convert_tx_param_to_chars(tx,
+                                           &pk,
+                                           &g_buffers[curr * MAX_BUFFER_LEN],
+                                           MAX_BUFFER_LEN)) {
                 return false;
             }
             tag_pairs[(*nbPairs)].item = label_pk;
@@ -145,10 +199,10 @@ static bool handle_params(transaction_t *tx,
                              i + 1);
                     label_amount = &g_buffers[(curr++) * MAX_BUFFER_LEN];
                 }
-                if (!convert_param_to_chars(tx,
-                                            i + 2 + pubkey_num,
-                                            &g_buffers[curr * MAX_BUFFER_LEN],
-                                            MAX_BUFFER_LEN)) {
+                if (!convert_tx_param_to_chars(tx,
+                                               &amount_param,
+                                               &g_buffers[curr * MAX_BUFFER_LEN],
+                                               MAX_BUFFER_LEN)) {
                     return false;
                 }
                 tag_pairs[(*nbPairs)].item = label_amount;
@@ -163,16 +217,13 @@ static bool handle_params(transaction_t *tx,
             tag_pairs[*nbPairs].item = NODE_AMOUNT;
             tag_pairs[(*nbPairs)++].value = &g_buffers[(curr++) * MAX_BUFFER_LEN];
 
-            uint64_t amount = 0;
-            for (size_t i = 0; i < pubkey_num; i++) {
-                uint64_t tmp_amount = 0;
-                if (!convert_param_to_uint64_le(&tx->method.parameters[i + 2 + pubkey_num],
-                                                &tmp_amount)) {
-                    return false;
-                }
-                amount += tmp_amount;
+            // The total was summed by the parser
+            if (!amount_to_chars(&tx->method.group.total,
+                                 tx->contract.token_decimals,
+                                 &g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN],
+                                 AMOUNT_SIZE)) {
+                return false;
             }
-            format_u64(&g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN], AMOUNT_SIZE, amount);
             strlcat(&g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN], " ", AMOUNT_SIZE);
             strlcat(&g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN], tx->contract.ticker, AMOUNT_SIZE);
             tag_pairs[*nbPairs].item = total_amount_item;
@@ -180,37 +231,15 @@ static bool handle_params(transaction_t *tx,
         }
     }
 
-    // The transfer/transferV2 methods for native tokens can involve multi-to-multi operations,
-    // meaning there can be a series of 'from', 'to', and 'amount' fields that need to be iterated
-    // over.
-    if (methodcmp(&tx->method.name, METHOD_TRANSFER) ||
-        methodcmp(&tx->method.name, METHOD_TRANSFER_V2)) {
-        uint8_t state_num = 1;
-        while (tx->method.parameters[3 * state_num].data != NULL &&
-               3 * state_num + 2 < PARAMETERS_MAX_NUM) {
-            for (uint8_t i = 0; i < 3; i++) {
-                uint8_t index = i + 3 * state_num;
-                uint8_t pos = configs[i].pos + 3 * state_num;
-                if (!convert_param_to_chars(tx,
-                                            index,
-                                            &g_buffers[index * MAX_BUFFER_LEN],
-                                            MAX_BUFFER_LEN)) {
-                    return false;
-                }
-                tag_pairs[pos].item = configs[i].item;
-                tag_pairs[pos].value = &g_buffers[index * MAX_BUFFER_LEN];
-            }
-            state_num++;
-            *nbPairs += 3;
-        }
-    }
     return true;
 }
 
 static bool calc_gas_chars(char *buffer, size_t buffer_len) {
     uint64_t gp = G_context.tx_info.transaction.header.gas_price;
     uint64_t gl = G_context.tx_info.transaction.header.gas_limit;
-    if (buffer == NULL || !format_fpu64_trimmed(buffer, buffer_len, gp * gl, ONG_DECIMALS)) {
+    amount_t fee;
+    amount_mul_u64(gp, gl, &fee);
+    if (buffer == NULL || !amount_to_chars(&fee, ONG_DECIMALS, buffer, buffer_len)) {
         return false;
     }
     strlcat(buffer, " ", buffer_len);
@@ -219,19 +248,27 @@ static bool calc_gas_chars(char *buffer, size_t buffer_len) {
     return true;
 }
 
+// A staged transaction goes to review as soon as the status of the previous one is dismissed
+static void review_done(void) {
+    if (!tx_queue_review_staged()) {
+        ui_menu_main();
+    }
+}
+
 static void review_choice(bool confirm) {
     validate_transaction(confirm);
     nbgl_useCaseReviewStatus(
         confirm ? STATUS_TYPE_TRANSACTION_SIGNED : STATUS_TYPE_TRANSACTION_REJECTED,
-        ui_menu_main);
+        review_done);
 }
 
-static int ui_display_bs_transaction() {
+static uint16_t ui_display_bs_transaction() {
     g_pairs[g_pairList.nbPairs].item = BLIND_SIGN_TX;
     g_pairs[g_pairList.nbPairs++].value = BLIND_SIGNING;
 
     size_t addr_len = G_context.tx_info.transaction.contract.addr.len;
-    uint8_t *addr = G_context.tx_info.transaction.contract.addr.data;
+    uint8_t *addr = param_data(G_context.tx_info.transaction.raw,
+                               &G_context.tx_info.transaction.contract.addr);
     format_hex(addr, addr_len, &g_buffers[0], MAX_BUFFER_LEN);
     g_pairs[g_pairList.nbPairs].item = CONTRACT_ADDRESS;
     g_pairs[g_pairList.nbPairs++].value = &g_buffers[0];
@@ -240,7 +277,7 @@ static int ui_display_bs_transaction() {
     g_pairs[g_pairList.nbPairs++].value = &g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN + AMOUNT_SIZE];
 
     g_pairs[g_pairList.nbPairs].item = SIGNER;
-    g_pairs[g_pairList.nbPairs++].value = &g_buffers[(PARAMETERS_MAX_NUM + 1) * MAX_BUFFER_LEN];
+    g_pairs[g_pairList.nbPairs++].value = G_context.signer_address;
 
     nbgl_useCaseReviewBlindSigning(TYPE_TRANSACTION,
                                    &g_pairList,
@@ -254,23 +291,29 @@ static int ui_display_bs_transaction() {
 #endif
                                     NULL,
                                    review_choice);
-    return 0;
+    return SW_OK;
 }
 
-static int ui_display_normal_transaction() {
+static uint16_t ui_display_normal_transaction() {
     const method_display_t *method = init_dipslay_pos_and_item(&G_context.tx_info.transaction);
     if (method == NULL) {
-        return io_send_sw(SW_INVALID_TRANSACTION);
+        return SW_INVALID_TRANSACTION;
     }
     if (!handle_params(&G_context.tx_info.transaction, method, g_pairs, &g_pairList.nbPairs)) {
-        return io_send_sw(SW_INVALID_TRANSACTION);
+        return SW_INVALID_TRANSACTION;
     }
 
     g_pairs[g_pairList.nbPairs].item = GAS_FEE;
     g_pairs[g_pairList.nbPairs++].value = &g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN + AMOUNT_SIZE];
 
     g_pairs[g_pairList.nbPairs].item = SIGNER;
-    g_pairs[g_pairList.nbPairs++].value = &g_buffers[(PARAMETERS_MAX_NUM + 1) * MAX_BUFFER_LEN];
+    g_pairs[g_pairList.nbPairs++].value = G_context.signer_address;
+
+    if (g_lazy_pairs_num != 0) {
+        g_pairList.pairs = NULL;
+        g_pairList.callback = get_tag_value_pair;
+        g_pairList.nbPairs += g_lazy_pairs_num;
+    }
 
     nbgl_useCaseReview(TYPE_TRANSACTION,
                        &g_pairList,
@@ -283,29 +326,26 @@ static int ui_display_normal_transaction() {
                         NULL,
 #endif
                        review_choice);
-    return 0;
+    return SW_OK;
 }
 
-int ui_display_transaction(bool is_blind_signed) {
+uint16_t ui_review_transaction(bool is_blind_signed) {
     if (G_context.req_type != CONFIRM_TRANSACTION || G_context.state != STATE_PARSED) {
         G_context.state = STATE_NONE;
-        return io_send_sw(SW_BAD_STATE);
+        return SW_BAD_STATE;
     }
 
     explicit_bzero(&g_buffers, sizeof(g_buffers));
 
     explicit_bzero(&g_pairList, sizeof(g_pairList));
+    g_lazy_pairs_num = 0;
+    clear_address_memo();
     g_pairList.pairs = g_pairs;
     g_pairList.nbPairs = 0;
 
     if (!calc_gas_chars(&g_buffers[PARAMETERS_MAX_NUM * MAX_BUFFER_LEN + AMOUNT_SIZE],
                         MAX_BUFFER_LEN)) {
-        return io_send_sw(SW_INVALID_TRANSACTION);
-    }
-
-    if (!derive_address_from_bip32_path(&g_buffers[(PARAMETERS_MAX_NUM + 1) * MAX_BUFFER_LEN],
-                                        MAX_BUFFER_LEN)) {
-        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        return SW_INVALID_TRANSACTION;
     }
 
     if (is_blind_signed) {
@@ -313,7 +353,11 @@ int ui_display_transaction(bool is_blind_signed) {
     } else {
         return ui_display_normal_transaction();
     }
-    return 0;
+}
+
+int ui_display_transaction(bool is_blind_signed) {
+    uint16_t sw = ui_review_transaction(is_blind_signed);
+    return sw == SW_OK ? 0 : io_send_sw(sw);
 }
 
 #endif
\ No newline at end of file
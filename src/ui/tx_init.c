@@ -17,6 +17,7 @@
 
 #include "tx_init.h"
 #include "types.h"
+#include "address.h"
 #include "../transaction/contract.h"
 #include "../transaction/utils.h"
 
@@ -29,6 +30,48 @@
 
 #define MAX_CONFIGS 7  // Max number of param_config_t entries per method
 
+// Base58 addresses rendered for the current request, keyed by script hash: the from and to
+// addresses are usually repeated across the transfer states, and pages are rendered again when
+// the user goes back. Entries are replaced in a round-robin way.
+#define ADDRESS_MEMO_NUM 4
+static struct {
+    uint8_t script_hash[ADDRESS_SCRIPT_HASH_LEN];
+    char address[BASE58_ADDRESS_LEN + 1];
+} g_address_memo[ADDRESS_MEMO_NUM];
+static uint8_t g_address_memo_num;   // number of valid entries
+static uint8_t g_address_memo_next;  // entry replaced once they are all valid
+
+void clear_address_memo(void) {
+    explicit_bzero(g_address_memo, sizeof(g_address_memo));
+    g_address_memo_num = 0;
+    g_address_memo_next = 0;
+}
+
+static bool convert_script_hash_to_address_memo(const uint8_t *script_hash,
+                                                char *buffer,
+                                                size_t buffer_len) {
+    for (uint8_t i = 0; i < g_address_memo_num; i++) {
+        if (memcmp(g_address_memo[i].script_hash, script_hash, ADDRESS_SCRIPT_HASH_LEN) == 0) {
+            return strlcpy(buffer, g_address_memo[i].address, buffer_len) < buffer_len;
+        }
+    }
+
+    if (!convert_script_hash_to_base58_address(buffer, buffer_len, script_hash)) {
+        return false;
+    }
+
+    uint8_t i = g_address_memo_num;
+    if (g_address_memo_num < ADDRESS_MEMO_NUM) {
+        g_address_memo_num++;
+    } else {
+        i = g_address_memo_next;
+        g_address_memo_next = (g_address_memo_next + 1) % ADDRESS_MEMO_NUM;
+    }
+    memcpy(g_address_memo[i].script_hash, script_hash, ADDRESS_SCRIPT_HASH_LEN);
+    strlcpy(g_address_memo[i].address, buffer, sizeof(g_address_memo[i].address));
+    return true;
+}
+
 const method_display_t *init_dipslay_pos_and_item(const transaction_t *tx) {
     static method_display_t method;
     static param_config_t configs[MAX_CONFIGS];
@@ -37,190 +80,221 @@ const method_display_t *init_dipslay_pos_and_item(const transaction_t *tx) {
         return NULL;
     }
 
-    const uint8_t *method_data = tx->method.name.data;
-    size_t method_len = tx->method.name.len;
-
-    if (method_data == NULL || method_len == 0) {
+    if (tx->raw == NULL || tx->method.name.len == 0) {
         return NULL;
     }   
 
-    if (methodcmp(&tx->method.name, METHOD_TRANSFER)) {
-        method.title = TRANSFER_TITLE;    
-        method.finish_title = TRANSFER_CONTENT;
-        if (tx->contract.type != NEOVM_CONTRACT) {
+    switch (tx->method.id) {
+        case METHOD_ID_TRANSFER:
+            method.title = TRANSFER_TITLE;
+            method.finish_title = TRANSFER_CONTENT;
+            if (tx->contract.type != NEOVM_CONTRACT) {
+                configs[0] = (param_config_t) {FROM, 0};
+                configs[1] = (param_config_t) {TO, 2};
+                configs[2] = (param_config_t) {AMOUNT, 1};
+            } else {
+                configs[0] = (param_config_t) {AMOUNT, 1};
+                configs[1] = (param_config_t) {TO, 2};
+                configs[2] = (param_config_t) {FROM, 0};
+            }
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_TRANSFER_V2:
+            method.title = TRANSFER_TITLE;
+            method.finish_title = TRANSFER_CONTENT;
             configs[0] = (param_config_t) {FROM, 0};
             configs[1] = (param_config_t) {TO, 2};
             configs[2] = (param_config_t) {AMOUNT, 1};
-        } else {
-            configs[0] = (param_config_t) {AMOUNT, 1};
-            configs[1] = (param_config_t) {TO, 2};
-            configs[2] = (param_config_t) {FROM, 0};
-        }
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_TRANSFER_V2)) {
-        method.title = TRANSFER_TITLE;
-        method.finish_title = TRANSFER_CONTENT;
-        configs[0] = (param_config_t) {FROM, 0};
-        configs[1] = (param_config_t) {TO, 2};
-        configs[2] = (param_config_t) {AMOUNT, 1};
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_TRANSFER_FROM)) {
-        method.title = TRANSFER_FROM_TITLE;
-        method.finish_title = TRANSFER_FROM_CONTENT;
-        if (tx->contract.type != NEOVM_CONTRACT) {
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_TRANSFER_FROM:
+            method.title = TRANSFER_FROM_TITLE;
+            method.finish_title = TRANSFER_FROM_CONTENT;
+            if (tx->contract.type != NEOVM_CONTRACT) {
+                configs[0] = (param_config_t) {SPENDER, 0};
+                configs[1] = (param_config_t) {FROM, 1};
+                configs[2] = (param_config_t) {TO, 3};
+                configs[3] = (param_config_t) {AMOUNT, 2};
+            } else {
+                configs[0] = (param_config_t) {AMOUNT, 2};
+                configs[1] = (param_config_t) {TO, 3};
+                configs[2] = (param_config_t) {FROM, 1};
+                configs[3] = (param_config_t) {SPENDER, 0};
+            }
+            method.configs = configs;
+            method.config_count = 4;
+            break;
+        case METHOD_ID_TRANSFER_FROM_V2:
+            method.title = TRANSFER_FROM_TITLE;
+            method.finish_title = TRANSFER_FROM_CONTENT;
             configs[0] = (param_config_t) {SPENDER, 0};
             configs[1] = (param_config_t) {FROM, 1};
             configs[2] = (param_config_t) {TO, 3};
             configs[3] = (param_config_t) {AMOUNT, 2};
-        } else {
-            configs[0] = (param_config_t) {AMOUNT, 2};
-            configs[1] = (param_config_t) {TO, 3};
-            configs[2] = (param_config_t) {FROM, 1};
-            configs[3] = (param_config_t) {SPENDER, 0};
-        }
-        method.configs = configs;
-        method.config_count = 4;
-    } else if (methodcmp(&tx->method.name, METHOD_TRANSFER_FROM_V2)) {
-        method.title = TRANSFER_FROM_TITLE;
-        method.finish_title = TRANSFER_FROM_CONTENT;
-        configs[0] = (param_config_t) {SPENDER, 0};
-        configs[1] = (param_config_t) {FROM, 1};
-        configs[2] = (param_config_t) {TO, 3};
-        configs[3] = (param_config_t) {AMOUNT, 2};
-        method.configs = configs;
-        method.config_count = 4;
-    } else if (methodcmp(&tx->method.name, METHOD_APPROVE)) {
-        method.title = APPROVE_TITLE;
-        method.finish_title = APPROVE_CONTENT;
-        if (tx->contract.type != NEOVM_CONTRACT) {
+            method.configs = configs;
+            method.config_count = 4;
+            break;
+        case METHOD_ID_APPROVE:
+            method.title = APPROVE_TITLE;
+            method.finish_title = APPROVE_CONTENT;
+            if (tx->contract.type != NEOVM_CONTRACT) {
+                configs[0] = (param_config_t) {FROM, 0};
+                configs[1] = (param_config_t) {TO, 2};
+                configs[2] = (param_config_t) {AMOUNT, 1};
+            } else {
+                configs[0] = (param_config_t) {AMOUNT, 1};
+                configs[1] = (param_config_t) {TO, 2};
+                configs[2] = (param_config_t) {FROM, 0};
+            }
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_APPROVE_V2:
+            method.title = APPROVE_TITLE;
+            method.finish_title = APPROVE_CONTENT;
             configs[0] = (param_config_t) {FROM, 0};
             configs[1] = (param_config_t) {TO, 2};
             configs[2] = (param_config_t) {AMOUNT, 1};
-        } else {
-            configs[0] = (param_config_t) {AMOUNT, 1};
-            configs[1] = (param_config_t) {TO, 2};
-            configs[2] = (param_config_t) {FROM, 0};
-        }
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_APPROVE_V2)) {
-        method.title = APPROVE_TITLE;
-        method.finish_title = APPROVE_CONTENT;
-        configs[0] = (param_config_t) {FROM, 0};
-        configs[1] = (param_config_t) {TO, 2};
-        configs[2] = (param_config_t) {AMOUNT, 1};
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_REGISTER_CANDIDATE)) {
-        method.title = REGISTER_CANDIDATE_TITLE;
-        method.finish_title = REGISTER_CANDIDATE_CONTENT;
-        configs[0] = (param_config_t) {PEER_PUBKEY, 1};
-        configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
-        configs[2] = (param_config_t) {STAKE_AMOUNT, 2};
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_QUIT_NODE)) {
-        method.title = QUIT_NODE_TITLE;
-        method.finish_title = QUIT_NODE_CONTENT;
-        configs[0] = (param_config_t) {PEER_PUBKEY, 1};
-        configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
-        method.configs = configs;
-        method.config_count = 2;
-    } else if (methodcmp(&tx->method.name, METHOD_ADD_INIT_POS)) {
-        method.title = ADD_INIT_POS_TITLE;
-        method.finish_title = ADD_INIT_POS_CONTENT;
-        configs[0] = (param_config_t) {PEER_PUBKEY, 1};
-        configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
-        configs[2] = (param_config_t) {STAKE_AMOUNT, 2};
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_REDUCE_INIT_POS)) {
-        method.title = REDUCE_INIT_POS_TITLE;
-        method.finish_title = REDUCE_INIT_POS_CONTENT;
-        configs[0] = (param_config_t) {PEER_PUBKEY, 1};
-        configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
-        configs[2] = (param_config_t) {AMOUNT, 2};
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_CHANGE_MAX_AUTH)) {
-        method.title = CHANGE_MAX_AUTHORIZATION_TITLE;
-        method.finish_title = CHANGE_MAX_AUTHORIZATION_CONTENT;
-        configs[0] = (param_config_t) {PEER_PUBKEY, 1};
-        configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
-        configs[2] = (param_config_t) {MAX_AUTHORIZE, 2};
-        method.configs = configs;
-        method.config_count = 3;
-    } else if (methodcmp(&tx->method.name, METHOD_SET_FEE_PERCENTAGE)) {
-        method.title = SET_FEE_PERCENTAGE_TITLE;
-        method.finish_title = SET_FEE_PERCENTAGE_CONTENT;
-        configs[0] = (param_config_t) {PEER_PUBKEY, 1};
-        configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
-        configs[2] = (param_config_t) {PEER_INCENTIVE, 2};
-        configs[3] = (param_config_t) {USER_INCENTIVE, 3};
-        method.configs = configs;
-        method.config_count = 4;
-    } else if (methodcmp(&tx->method.name, METHOD_AUTHORIZE_FOR_PEER)) {
-        method.title = AUTHORIZE_FOR_PEER_TITLE;
-        method.finish_title = AUTHORIZE_FOR_PEER_CONTENT;
-        configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
-        method.configs = configs;
-        method.config_count = 1;
-    } else if (methodcmp(&tx->method.name, METHOD_UNAUTHORIZE_FOR_PEER)) {
-        method.title = UN_AUTHORIZE_FOR_PEER_TITLE;
-        method.finish_title = UN_AUTHORIZE_FOR_PEER_CONTENT;
-        configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
-        method.configs = configs;
-        method.config_count = 1;
-    } else if (methodcmp(&tx->method.name, METHOD_WITHDRAW)) {
-        method.title = WITHDRAW_TITLE;
-        method.finish_title = WITHDRAW_CONTENT;
-        configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
-        method.configs = configs;
-        method.config_count = 1;
-    } else if (methodcmp(&tx->method.name, METHOD_WITHDRAW_FEE)) {
-        method.title = WITHDRAW_FEE_TITLE;
-        method.finish_title = WITHDRAW_FEE_CONTENT;
-        configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
-        method.configs = configs;
-        method.config_count = 1;
-    } else {
-        return NULL;
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_REGISTER_CANDIDATE:
+            method.title = REGISTER_CANDIDATE_TITLE;
+            method.finish_title = REGISTER_CANDIDATE_CONTENT;
+            configs[0] = (param_config_t) {PEER_PUBKEY, 1};
+            configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
+            configs[2] = (param_config_t) {STAKE_AMOUNT, 2};
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_QUIT_NODE:
+            method.title = QUIT_NODE_TITLE;
+            method.finish_title = QUIT_NODE_CONTENT;
+            configs[0] = (param_config_t) {PEER_PUBKEY, 1};
+            configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
+            method.configs = configs;
+            method.config_count = 2;
+            break;
+        case METHOD_ID_ADD_INIT_POS:
+            method.title = ADD_INIT_POS_TITLE;
+            method.finish_title = ADD_INIT_POS_CONTENT;
+            configs[0] = (param_config_t) {PEER_PUBKEY, 1};
+            configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
+            configs[2] = (param_config_t) {STAKE_AMOUNT, 2};
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_REDUCE_INIT_POS:
+            method.title = REDUCE_INIT_POS_TITLE;
+            method.finish_title = REDUCE_INIT_POS_CONTENT;
+            configs[0] = (param_config_t) {PEER_PUBKEY, 1};
+            configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
+            configs[2] = (param_config_t) {AMOUNT, 2};
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_CHANGE_MAX_AUTH:
+            method.title = CHANGE_MAX_AUTHORIZATION_TITLE;
+            method.finish_title = CHANGE_MAX_AUTHORIZATION_CONTENT;
+            configs[0] = (param_config_t) {PEER_PUBKEY, 1};
+            configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
+            configs[2] = (param_config_t) {MAX_AUTHORIZE, 2};
+            method.configs = configs;
+            method.config_count = 3;
+            break;
+        case METHOD_ID_SET_FEE_PERCENTAGE:
+            method.title = SET_FEE_PERCENTAGE_TITLE;
+            method.finish_title = SET_FEE_PERCENTAGE_CONTENT;
+            configs[0] = (param_config_t) {PEER_PUBKEY, 1};
+            configs[1] = (param_config_t) {STAKE_ADDRESS, 0};
+            configs[2] = (param_config_t) {PEER_INCENTIVE, 2};
+            configs[3] = (param_config_t) {USER_INCENTIVE, 3};
+            method.configs = configs;
+            method.config_count = 4;
+            break;
+        case METHOD_ID_AUTHORIZE_FOR_PEER:
+            method.title = AUTHORIZE_FOR_PEER_TITLE;
+            method.finish_title = AUTHORIZE_FOR_PEER_CONTENT;
+            configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
+            method.configs = configs;
+            method.config_count = 1;
+            break;
+        case METHOD_ID_UNAUTHORIZE_FOR_PEER:
+            method.title = UN_AUTHORIZE_FOR_PEER_TITLE;
+            method.finish_title = UN_AUTHORIZE_FOR_PEER_CONTENT;
+            configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
+            method.configs = configs;
+            method.config_count = 1;
+            break;
+        case METHOD_ID_WITHDRAW:
+            method.title = WITHDRAW_TITLE;
+            method.finish_title = WITHDRAW_CONTENT;
+            configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
+            method.configs = configs;
+            method.config_count = 1;
+            break;
+        case METHOD_ID_WITHDRAW_FEE:
+            method.title = WITHDRAW_FEE_TITLE;
+            method.finish_title = WITHDRAW_FEE_CONTENT;
+            configs[0] = (param_config_t) {STAKE_ADDRESS, 0};
+            method.configs = configs;
+            method.config_count = 1;
+            break;
+        default:
+            return NULL;
     }
 
     return &method;
 }
 
 bool convert_param_to_chars(transaction_t *tx, uint8_t param_idx, char *buffer, size_t buffer_len) {
-    if (tx == NULL || buffer == NULL) {
+    if (tx == NULL) {
         PRINTF("Error: Null pointer in convert_param_to_chars\n");
         return false;
     }
 
-    tx_parameter_t *param = &tx->method.parameters[param_idx];
-    if (param_idx >= PARAMETERS_MAX_NUM || param == NULL || param->data == NULL) {
-        PRINTF("Error: param, idx %u, %p\n", param_idx, param->data);
+    if (param_idx >= PARAMETERS_MAX_NUM) {
+        PRINTF("Error: param, idx %u\n", param_idx);
+        return false;
+    }
+    return convert_tx_param_to_chars(tx, &tx->method.parameters[param_idx], buffer, buffer_len);
+}
+
+bool convert_tx_param_to_chars(transaction_t *tx,
+                               const tx_parameter_t *param,
+                               char *buffer,
+                               size_t buffer_len) {
+    if (tx == NULL || param == NULL || buffer == NULL) {
+        PRINTF("Error: Null pointer in convert_tx_param_to_chars\n");
+        return false;
+    }
+
+    if (param->len == 0) {
+        PRINTF("Error: param not set\n");
         return false;
     }
+    const uint8_t *data = param_data(tx->raw, param);
     explicit_bzero(buffer, buffer_len);
 
     switch (param->type) {
         case PARAM_ADDR:
-            if (!convert_script_hash_to_base58_address(buffer, buffer_len, param->data)) {
+            if (!convert_script_hash_to_address_memo(data, buffer, buffer_len)) {
                 return false;
             }
             break;
         case PARAM_UINT128:
         case PARAM_AMOUNT:
-            if (!convert_param_amount_to_chars(param,
+            if (!convert_param_amount_to_chars(tx->raw,
+                                               param,
                                                tx->contract.token_decimals,
                                                tx->contract.type != WASMVM_CONTRACT,
                                                buffer,
                                                buffer_len)) {
                 return false;
             }
-            if (methodcmp(&tx->method.name, METHOD_SET_FEE_PERCENTAGE)) {
+            if (tx->method.id == METHOD_ID_SET_FEE_PERCENTAGE) {
                 strlcat(buffer, PERCENTAGE, buffer_len);
             } else {
                 strlcat(buffer, " ", buffer_len);
@@ -230,7 +304,7 @@ bool convert_param_to_chars(transaction_t *tx, uint8_t param_idx, char *buffer,
             break;
         case PARAM_PUBKEY:
             if (param->len <= buffer_len) {
-                memcpy(buffer, param->data, param->len);
+                memcpy(buffer, data, param->len);
                 buffer[param->len] = '\0';
                 return true;
             } else {
@@ -36,4 +36,23 @@ const method_display_t *init_dipslay_pos_and_item(const transaction_t *tx);
  * @param buffer_len Length of the buffer to ensure no overflow occurs.
  * @return true if the conversion is successful, false otherwise.
  */
-bool convert_param_to_chars(transaction_t *tx, uint8_t param_idx, char *buffer, size_t buffer_len);
\ No newline at end of file
+bool convert_param_to_chars(transaction_t *tx, uint8_t param_idx, char *buffer, size_t buffer_len);
+/**
+ * @brief Converts a parameter decoded from the transaction into a character string.
+ *        Used for the parameters of a group, which are not stored in the transaction.
+ *
+ * @param tx Pointer to the transaction structure the parameter belongs to.
+ * @param param Pointer to the parameter to convert.
+ * @param buffer Pointer to the buffer where the converted string will be stored.
+ * @param buffer_len Length of the buffer to ensure no overflow occurs.
+ * @return true if the conversion is successful, false otherwise.
+ */
+bool convert_tx_param_to_chars(transaction_t *tx,
+                               const tx_parameter_t *param,
+                               char *buffer,
+                               size_t buffer_len);
+
+/**
+ * @brief Forgets the base58 addresses memoized while rendering the parameters of a request.
+ */
+void clear_address_memo(void);
@@ -76,3 +76,10 @@
 
 #define PERSONAL_MSG_TITLE   "Review message"
 #define PERSONAL_MSG_CONTENT "Sign message?"
+
+#define BATCH_TITLE        "Review batch of transactions"
+#define BATCH_CONTENT      "Sign batch of transactions?"
+#define BATCH_TX_COUNT     "Transactions"
+#define BATCH_TOTAL_AMOUNT TOTAL_PLUS AMOUNT
+#define BATCH_TOTAL_GAS    TOTAL_PLUS GAS_FEE
+#define BATCH_RECIPIENTS   "Recipients"
@@ -5,6 +5,8 @@ from contextlib import contextmanager
 from ragger.backend.interface import BackendInterface, RAPDU
 from ragger.bip import pack_derivation_path
 
+from .boilerplate_tx_template import pack_template
+
 
 MAX_APDU_LEN: int = 255
 
@@ -17,12 +19,27 @@ class P1(IntEnum):
     P1_MAX   = 0x1B
     # Parameter 1 for screen confirmation for GET_PUBLIC_KEY.
     P1_CONFIRM = 0x01
+    # Parameter 1 for script hashes instead of compressed keys for GET_PUBLIC_KEYS.
+    P1_SCRIPT_HASH = 0x01
 
 class P2(IntEnum):
     # Parameter 2 for last APDU to receive.
     P2_LAST = 0x00
     # Parameter 2 for more APDU to receive.
     P2_MORE = 0x80
+    # Parameter 2 for last APDU of a queued SIGN_TX, answered before the review.
+    P2_QUEUE = 0x01
+    # Parameter 2 flag for a first APDU using the path of the session, with data.
+    P2_SESSION = 0x40
+    # Parameter 2 flag for template encoded transaction data.
+    P2_TEMPLATE = 0x20
+
+class PubkeyFormat(IntEnum):
+    # Parameter 2 for the response format of GET_PUBLIC_KEY.
+    UNCOMPRESSED = 0x00
+    COMPRESSED   = 0x01
+    SCRIPT_HASH  = 0x02
+    ADDRESS      = 0x03
 
 class InsType(IntEnum):
     SIGN_TX = 0x02
@@ -30,6 +47,18 @@ class InsType(IntEnum):
     GET_PUBLIC_KEY = 0x04
     GET_APP_NAME = 0x05
     SIGN_PERSONAL_MESSAGE = 0x07
+    GET_PUBLIC_KEYS = 0x08
+    SIGN_TX_BATCH = 0x09
+    SIGN_TX_RESULT = 0x0A
+    OPEN_SESSION = 0x0B
+    CLOSE_SESSION = 0x0C
+
+class BatchStep(IntEnum):
+    # Parameter 1 for the steps of SIGN_TX_BATCH.
+    PATH       = 0x00
+    TX         = 0x01
+    END        = 0x02
+    SIGNATURES = 0x03
 
 class Errors(IntEnum):
     SW_DENY                    = 0x6985
@@ -49,6 +78,7 @@ class Errors(IntEnum):
     SW_PERSONAL_MSG_PARSING_FAIL = 0xB009
     SW_INVALID_TRANSACTION     = 0xB00A
     SW_INVALID_PATH           = 0xB00B
+    SW_REVIEW_PENDING          = 0xB00C
 
 
 def split_message(message: bytes, max_size: int) -> List[bytes]:
@@ -84,20 +114,30 @@ class BoilerplateCommandSender:
                                      data=b"")
 
 
-    def get_public_key(self, path: str) -> RAPDU:
+    def get_public_key(self, path: str, pubkey_format: PubkeyFormat = PubkeyFormat.UNCOMPRESSED) -> RAPDU:
         return self.backend.exchange(cla=CLA,
                                      ins=InsType.GET_PUBLIC_KEY,
                                      p1=P1.P1_START,
-                                     p2=P2.P2_LAST,
+                                     p2=pubkey_format,
                                      data=pack_derivation_path(path))
 
 
+    def get_public_keys(self, path: str, first_index: int, count: int, script_hash: bool = False) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.GET_PUBLIC_KEYS,
+                                     p1=P1.P1_SCRIPT_HASH if script_hash else P1.P1_START,
+                                     p2=P2.P2_LAST,
+                                     data=pack_derivation_path(path)
+                                     + first_index.to_bytes(4, byteorder="big")
+                                     + count.to_bytes(1, byteorder="big"))
+
+
     @contextmanager
-    def get_public_key_with_confirmation(self, path: str) -> Generator[None, None, None]:
+    def get_public_key_with_confirmation(self, path: str, pubkey_format: PubkeyFormat = PubkeyFormat.UNCOMPRESSED) -> Generator[None, None, None]:
         with self.backend.exchange_async(cla=CLA,
                                          ins=InsType.GET_PUBLIC_KEY,
                                          p1=P1.P1_CONFIRM,
-                                         p2=P2.P2_LAST,
+                                         p2=pubkey_format,
                                          data=pack_derivation_path(path)) as response:
             yield response
 
@@ -127,6 +167,171 @@ class BoilerplateCommandSender:
                                          data=messages[-1]) as response:
             yield response
 
+    # Path and transaction in one APDU, for a transaction which fits after the path
+    @contextmanager
+    def sign_tx_single(self, path: str, transaction: bytes) -> Generator[None, None, None]:
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX,
+                                         p1=P1.P1_START,
+                                         p2=P2.P2_LAST,
+                                         data=pack_derivation_path(path) + transaction) as response:
+            yield response
+
+    # Send the transaction as template operations instead of raw bytes
+    @contextmanager
+    def sign_tx_template(self, path: str, ops: List[bytes]) -> Generator[None, None, None]:
+        self.backend.exchange(cla=CLA,
+                              ins=InsType.SIGN_TX,
+                              p1=P1.P1_START,
+                              p2=P2.P2_MORE,
+                              data=pack_derivation_path(path))
+        messages = pack_template(ops, MAX_APDU_LEN)
+        idx: int = P1.P1_START + 1
+
+        for msg in messages[:-1]:
+            self.backend.exchange(cla=CLA,
+                                  ins=InsType.SIGN_TX,
+                                  p1=idx,
+                                  p2=P2.P2_MORE | P2.P2_TEMPLATE,
+                                  data=msg)
+            idx += 1
+
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX,
+                                         p1=idx,
+                                         p2=P2.P2_LAST | P2.P2_TEMPLATE,
+                                         data=messages[-1]) as response:
+            yield response
+
+    def sign_tx_queued(self, path: str, transaction: bytes) -> RAPDU:
+        self.backend.exchange(cla=CLA,
+                              ins=InsType.SIGN_TX,
+                              p1=P1.P1_START,
+                              p2=P2.P2_MORE,
+                              data=pack_derivation_path(path))
+        messages = split_message(transaction, MAX_APDU_LEN)
+        idx: int = P1.P1_START + 1
+
+        for msg in messages[:-1]:
+            self.backend.exchange(cla=CLA,
+                                  ins=InsType.SIGN_TX,
+                                  p1=idx,
+                                  p2=P2.P2_MORE,
+                                  data=msg)
+            idx += 1
+
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.SIGN_TX,
+                                     p1=idx,
+                                     p2=P2.P2_QUEUE,
+                                     data=messages[-1])
+
+
+    def sign_tx_result(self) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.SIGN_TX_RESULT,
+                                     p1=P1.P1_START,
+                                     p2=P2.P2_LAST,
+                                     data=b"")
+
+
+    def open_session(self, path: str) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.OPEN_SESSION,
+                                     p1=P1.P1_START,
+                                     p2=P2.P2_LAST,
+                                     data=pack_derivation_path(path))
+
+
+    def close_session(self) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.CLOSE_SESSION,
+                                     p1=P1.P1_START,
+                                     p2=P2.P2_LAST,
+                                     data=b"")
+
+
+    # Sign with the path of the session, the first APDU holds transaction data
+    @contextmanager
+    def sign_tx_in_session(self, transaction: bytes) -> Generator[None, None, None]:
+        messages = split_message(transaction, MAX_APDU_LEN)
+
+        for idx, msg in enumerate(messages[:-1]):
+            self.backend.exchange(cla=CLA,
+                                  ins=InsType.SIGN_TX,
+                                  p1=idx,
+                                  p2=P2.P2_MORE | (P2.P2_SESSION if idx == 0 else 0),
+                                  data=msg)
+
+        idx = len(messages) - 1
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX,
+                                         p1=idx,
+                                         p2=P2.P2_LAST | (P2.P2_SESSION if idx == 0 else 0),
+                                         data=messages[-1]) as response:
+            yield response
+
+
+    @contextmanager
+    def sign_tx_batch(self, path: str, transactions: List[bytes]) -> Generator[None, None, None]:
+        self.backend.exchange(cla=CLA,
+                              ins=InsType.SIGN_TX_BATCH,
+                              p1=BatchStep.PATH,
+                              p2=P2.P2_MORE,
+                              data=pack_derivation_path(path))
+
+        for transaction in transactions:
+            messages = split_message(transaction, MAX_APDU_LEN)
+            for i, msg in enumerate(messages):
+                self.backend.exchange(cla=CLA,
+                                      ins=InsType.SIGN_TX_BATCH,
+                                      p1=BatchStep.TX,
+                                      p2=P2.P2_LAST if i == len(messages) - 1 else P2.P2_MORE,
+                                      data=msg)
+
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX_BATCH,
+                                         p1=BatchStep.END,
+                                         p2=P2.P2_LAST,
+                                         data=b"") as response:
+            yield response
+
+
+    # Each transaction is sent as template operations, which can repeat a payer or from
+    # of the previous transactions
+    @contextmanager
+    def sign_tx_batch_template(self, path: str, transactions: List[List[bytes]]) -> Generator[None, None, None]:
+        self.backend.exchange(cla=CLA,
+                              ins=InsType.SIGN_TX_BATCH,
+                              p1=BatchStep.PATH,
+                              p2=P2.P2_MORE,
+                              data=pack_derivation_path(path))
+
+        for ops in transactions:
+            messages = pack_template(ops, MAX_APDU_LEN)
+            for i, msg in enumerate(messages):
+                self.backend.exchange(cla=CLA,
+                                      ins=InsType.SIGN_TX_BATCH,
+                                      p1=BatchStep.TX,
+                                      p2=(P2.P2_LAST if i == len(messages) - 1 else P2.P2_MORE) | P2.P2_TEMPLATE,
+                                      data=msg)
+
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_TX_BATCH,
+                                         p1=BatchStep.END,
+                                         p2=P2.P2_LAST,
+                                         data=b"") as response:
+            yield response
+
+
+    def get_batch_signatures(self, first: int) -> RAPDU:
+        return self.backend.exchange(cla=CLA,
+                                     ins=InsType.SIGN_TX_BATCH,
+                                     p1=BatchStep.SIGNATURES,
+                                     p2=P2.P2_LAST,
+                                     data=first.to_bytes(1, byteorder="big"))
+
+
     @contextmanager
     def sign_personal_msg(self, path: str, personalmsg: bytes) -> Generator[None, None, None]:
         self.backend.exchange(cla=CLA,
@@ -153,5 +358,16 @@ class BoilerplateCommandSender:
             yield response
 
 
+    # Path and message in one APDU, for a message which fits after the path
+    @contextmanager
+    def sign_personal_msg_single(self, path: str, personalmsg: bytes) -> Generator[None, None, None]:
+        with self.backend.exchange_async(cla=CLA,
+                                         ins=InsType.SIGN_PERSONAL_MESSAGE,
+                                         p1=P1.P1_START,
+                                         p2=P2.P2_LAST,
+                                         data=pack_derivation_path(path) + personalmsg) as response:
+            yield response
+
+
     def get_async_response(self) -> Optional[RAPDU]:
         return self.backend.last_async_response
@@ -1,4 +1,4 @@
-from typing import Tuple
+from typing import List, Tuple
 from struct import unpack
 
 # remainder, data_len, data
@@ -57,6 +57,27 @@ def unpack_get_public_key_response(response: bytes) -> Tuple[int, bytes, int, by
 
     return pub_key_len, pub_key, chain_code_len, chain_code
 
+# Unpack from response:
+# response = key_len (1)
+#            key (var): compressed key, script hash or base58 address
+def unpack_get_public_key_compact_response(response: bytes, key_len: int) -> bytes:
+    response, data_len, key = pop_size_prefixed_buf_from_buf(response)
+
+    assert data_len == key_len
+    assert len(response) == 0
+
+    return key
+
+# Unpack from response:
+# response = keys_num (1)
+#            keys (keys_num * key_len)
+def unpack_get_public_keys_response(response: bytes, key_len: int) -> List[bytes]:
+    response, keys_num = pop_sized_buf_from_buffer(response, 1)
+
+    assert len(response) == keys_num[0] * key_len
+
+    return [response[i:i + key_len] for i in range(0, len(response), key_len)]
+
 # Unpack from response:
 # response = der_sig_len (1)
 #            der_sig (var)
@@ -69,6 +90,24 @@ def unpack_sign_tx_response(response: bytes) -> Tuple[int, bytes, int]:
 
     return der_sig_len, der_sig, int.from_bytes(v, byteorder='big')
 
+# Unpack from response:
+# response = sigs_num (1)
+#            der_sig_len (1)
+#            der_sig (var)
+#            v (1)
+#            ...
+def unpack_sign_tx_batch_response(response: bytes) -> List[Tuple[int, bytes, int]]:
+    response, sigs_num = pop_sized_buf_from_buffer(response, 1)
+    signatures = []
+    for _ in range(sigs_num[0]):
+        response, der_sig_len, der_sig = pop_size_prefixed_buf_from_buf(response)
+        response, v = pop_sized_buf_from_buffer(response, 1)
+        signatures.append((der_sig_len, der_sig, int.from_bytes(v, byteorder='big')))
+
+    assert len(response) == 0
+
+    return signatures
+
 # Unpack from response:
 # response = der_sig_len (1)
 #            der_sig (var)
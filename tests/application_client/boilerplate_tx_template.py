@@ -0,0 +1,45 @@
+from enum import IntEnum
+from typing import List, Optional
+
+
+class TemplateOp(IntEnum):
+    LITERAL = 0x00
+    HEADER = 0x01
+    TRANSFER_STATE = 0x02
+    NATIVE_TAIL = 0x03
+
+
+# Flag of HEADER and TRANSFER_STATE, the address is the last payer or from sent in full
+REPEAT_ADDRESS = 0x01
+
+
+def template_literal(data: bytes) -> bytes:
+    return bytes([TemplateOp.LITERAL, len(data)]) + data
+
+
+# header is the 22 bytes before the payer, version to gas limit
+def template_header(header: bytes, payer: Optional[bytes] = None) -> bytes:
+    if payer is None:
+        return bytes([TemplateOp.HEADER, REPEAT_ADDRESS]) + header
+    return bytes([TemplateOp.HEADER, 0]) + header + payer
+
+
+# amount is the NeoVM push instruction of the raw transaction
+def template_transfer_state(to: bytes, amount: bytes, from_: Optional[bytes] = None) -> bytes:
+    if from_ is None:
+        return bytes([TemplateOp.TRANSFER_STATE, REPEAT_ADDRESS]) + to + amount
+    return bytes([TemplateOp.TRANSFER_STATE, 0]) + from_ + to + amount
+
+
+def template_native_tail(contract: int) -> bytes:
+    return bytes([TemplateOp.NATIVE_TAIL, contract])
+
+
+# Group whole operations into chunks, an operation is never split between two APDUs
+def pack_template(ops: List[bytes], max_size: int) -> List[bytes]:
+    chunks: List[bytes] = [b""]
+    for op in ops:
+        if len(chunks[-1]) + len(op) > max_size:
+            chunks.append(b"")
+        chunks[-1] += op
+    return chunks
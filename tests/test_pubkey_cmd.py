@@ -6,8 +6,14 @@ from ragger.error import ExceptionRAPDU
 from ragger.backend.interface import BackendInterface
 from ragger.navigator.navigation_scenario import NavigateWithScenario
 
-from application_client.boilerplate_command_sender import BoilerplateCommandSender, Errors
-from application_client.boilerplate_response_unpacker import unpack_get_public_key_response
+from application_client.boilerplate_command_sender import BoilerplateCommandSender, Errors, PubkeyFormat
+from application_client.boilerplate_response_unpacker import unpack_get_public_key_response, unpack_get_public_keys_response, \
+    unpack_get_public_key_compact_response
+
+
+def compress_public_key(public_key: str) -> bytes:
+    raw = bytes.fromhex(public_key)
+    return bytes([0x03 if raw[64] & 1 else 0x02]) + raw[1:33]
 
 
 # In this test we check that the GET_PUBLIC_KEY works in non-confirmation mode
@@ -22,6 +28,42 @@ def test_get_public_key_no_confirm(backend):
         assert chain_code.hex() == ref_chain_code
 
 
+# In this test we check the keys derived from the cached account node, then read back from the cache
+def test_get_public_key_account_addresses(backend):
+    client = BoilerplateCommandSender(backend)
+    for i in [0, 1, 2, 3, 4, 1000, 0x7FFFFFFF, 2]:
+        path = f"m/44'/1024'/0'/0/{i}"
+        response = client.get_public_key(path=path).data
+        _, public_key, _, chain_code = unpack_get_public_key_response(response)
+
+        ref_public_key, ref_chain_code = calculate_public_key_and_chaincode(CurveChoice.Nist256p1, path=path)
+        assert public_key.hex() == ref_public_key
+        assert chain_code.hex() == ref_chain_code
+
+
+# In this test we check the compact response formats of GET_PUBLIC_KEY
+def test_get_public_key_formats(backend):
+    client = BoilerplateCommandSender(backend)
+    path = "m/44'/1024'/0'/0/3"
+    ref_public_key, _ = calculate_public_key_and_chaincode(CurveChoice.Nist256p1, path=path)
+
+    response = client.get_public_key(path=path, pubkey_format=PubkeyFormat.COMPRESSED).data
+    assert unpack_get_public_key_compact_response(response, 33) == compress_public_key(ref_public_key)
+
+    response = client.get_public_key(path=path, pubkey_format=PubkeyFormat.SCRIPT_HASH).data
+    script_hash = unpack_get_public_key_compact_response(response, 20)
+    response = client.get_public_keys(path="m/44'/1024'/0'/0", first_index=3, count=1, script_hash=True).data
+    assert unpack_get_public_keys_response(response, 20) == [script_hash]
+
+    response = client.get_public_key(path=path, pubkey_format=PubkeyFormat.ADDRESS).data
+    address = unpack_get_public_key_compact_response(response, 34).decode("ascii")
+    assert address.startswith("A")
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.get_public_key(path=path, pubkey_format=4)
+    assert e.value.status == Errors.SW_WRONG_P1P2
+
+
 # In this test we check that the GET_PUBLIC_KEY works in confirmation mode
 def test_get_public_key_confirm_accepted(backend, scenario_navigator):
     client = BoilerplateCommandSender(backend)
@@ -49,3 +91,43 @@ def test_get_public_key_confirm_refused(backend, scenario_navigator):
     # Assert that we have received a refusal
     assert e.value.status == Errors.SW_DENY
     assert len(e.value.data) == 0
+
+
+# In this test we check that GET_PUBLIC_KEYS returns the keys of consecutive indices, in as few responses as fit
+def test_get_public_keys_compressed(backend):
+    client = BoilerplateCommandSender(backend)
+    base_path = "m/44'/1024'/0'/0"
+    first_index = 5
+    count = 10
+
+    keys = []
+    while len(keys) < count:
+        response = client.get_public_keys(path=base_path,
+                                          first_index=first_index + len(keys),
+                                          count=count - len(keys)).data
+        batch = unpack_get_public_keys_response(response, 33)
+        assert 0 < len(batch) <= 7
+        keys += batch
+
+    for i, key in enumerate(keys):
+        ref_public_key, _ = calculate_public_key_and_chaincode(CurveChoice.Nist256p1,
+                                                               path=f"{base_path}/{first_index + i}")
+        assert key == compress_public_key(ref_public_key)
+
+
+# In this test we check that GET_PUBLIC_KEYS packs up to 12 script hashes in a response
+def test_get_public_keys_script_hash(backend):
+    client = BoilerplateCommandSender(backend)
+    response = client.get_public_keys(path="m/44'/1024'/0'/0", first_index=0, count=20, script_hash=True).data
+    hashes = unpack_get_public_keys_response(response, 20)
+    assert len(hashes) == 12
+    assert len(set(hashes)) == 12
+
+
+# In this test we check that GET_PUBLIC_KEYS rejects a range reaching the hardened indices
+def test_get_public_keys_hardened_range(backend):
+    client = BoilerplateCommandSender(backend)
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.get_public_keys(path="m/44'/1024'/0'/0", first_index=0x7FFFFFFF, count=2)
+
+    assert e.value.status == Errors.SW_INVALID_PATH
@@ -0,0 +1,65 @@
+import hashlib
+import pytest
+
+from ragger.error import ExceptionRAPDU
+
+from application_client.boilerplate_command_sender import BoilerplateCommandSender, Errors
+from application_client.boilerplate_response_unpacker import unpack_get_public_key_response, unpack_sign_tx_response
+from utils import check_signature_validity, hex_to_bytes
+
+# In these tests the path is sent once with OPEN_SESSION, the transactions start with their data
+
+# ONT transferV2 of two transfer states from the account of m/44'/1024'/0'/0/0
+TRANSFER = hex_to_bytes("00d1744716e1c409000000000000204e000000000000ae6393b337e4a8d856ec00d75af134fdcd6bfe29af00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc8149b50e5a049679c32e4660266f8814001bde3e6fc6a7cc80210276a7cc86c00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc814e7f1d24e2d3bb7fa3051c732507ee74753756ff36a7cc80210276a7cc86c52c10a7472616e7366657256321400000000000000000000000000000000000000010068164f6e746f6c6f67792e4e61746976652e496e766f6b6500")
+
+
+def tx_hash(transaction: bytes) -> bytes:
+    return hashlib.sha256(hashlib.sha256(transaction).digest()).digest()
+
+
+def test_sign_tx_in_session(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    client.open_session(path=path)
+
+    # Several transactions with the same session
+    for nonce in range(2):
+        transaction = TRANSFER[:2] + nonce.to_bytes(4, byteorder="little") + TRANSFER[6:]
+        with client.sign_tx_in_session(transaction=transaction):
+            scenario_navigator.review_approve()
+
+        _, der_sig, _ = unpack_sign_tx_response(client.get_async_response().data)
+        assert check_signature_validity(public_key, der_sig, tx_hash(transaction))
+
+    client.close_session()
+
+
+# Without an open session, a transaction cannot start without its path
+def test_sign_tx_session_closed(backend):
+    client = BoilerplateCommandSender(backend)
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_in_session(transaction=TRANSFER):
+            pass
+    assert e.value.status == Errors.SW_BAD_STATE
+
+    client.open_session(path="m/44'/1024'/0'/0/0")
+    client.close_session()
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_in_session(transaction=TRANSFER):
+            pass
+    assert e.value.status == Errors.SW_BAD_STATE
+
+
+# The path of a session is validated when it is opened
+def test_open_session_invalid_path(backend):
+    client = BoilerplateCommandSender(backend)
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.open_session(path="m/44'/60'/0'/0/0")
+    assert e.value.status == Errors.SW_INVALID_PATH
@@ -0,0 +1,88 @@
+import hashlib
+import pytest
+
+from ragger.error import ExceptionRAPDU
+
+from application_client.boilerplate_command_sender import BoilerplateCommandSender, Errors
+from application_client.boilerplate_response_unpacker import unpack_get_public_key_response, unpack_sign_tx_batch_response
+from utils import check_signature_validity, hex_to_bytes
+
+# In these tests we check the behavior of the device when asked to sign a batch of transactions
+
+# ONT transferV2 of two transfer states from the account of m/44'/1024'/0'/0/0
+TRANSFER = hex_to_bytes("00d1744716e1c409000000000000204e000000000000ae6393b337e4a8d856ec00d75af134fdcd6bfe29af00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc8149b50e5a049679c32e4660266f8814001bde3e6fc6a7cc80210276a7cc86c00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc814e7f1d24e2d3bb7fa3051c732507ee74753756ff36a7cc80210276a7cc86c52c10a7472616e7366657256321400000000000000000000000000000000000000010068164f6e746f6c6f67792e4e61746976652e496e766f6b6500")
+
+
+# The same transfer with another nonce
+def transfer_with_nonce(nonce: int) -> bytes:
+    return TRANSFER[:2] + nonce.to_bytes(4, byteorder="little") + TRANSFER[6:]
+
+
+def tx_hash(transaction: bytes) -> bytes:
+    return hashlib.sha256(hashlib.sha256(transaction).digest()).digest()
+
+
+# In this test we send a batch of transactions, approve its summary and check every signature,
+# more of them than fit in the response to the approval
+def test_sign_tx_batch(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    transactions = [transfer_with_nonce(nonce) for nonce in range(5)]
+    with client.sign_tx_batch(path=path, transactions=transactions):
+        scenario_navigator.review_approve()
+
+    signatures = unpack_sign_tx_batch_response(client.get_async_response().data)
+    assert 0 < len(signatures) < len(transactions)
+    while len(signatures) < len(transactions):
+        rapdu = client.get_batch_signatures(len(signatures))
+        signatures += unpack_sign_tx_batch_response(rapdu.data)
+
+    assert len(signatures) == len(transactions)
+    for transaction, (_, der_sig, _) in zip(transactions, signatures):
+        assert check_signature_validity(public_key, der_sig, tx_hash(transaction))
+
+
+# The summary of the batch is refused on screen
+def test_sign_tx_batch_refused(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_batch(path=path, transactions=[TRANSFER]):
+            scenario_navigator.review_reject()
+
+    assert e.value.status == Errors.SW_DENY
+    assert len(e.value.data) == 0
+
+    # The signatures of a refused batch cannot be retrieved
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.get_batch_signatures(0)
+    assert e.value.status == Errors.SW_BAD_STATE
+
+
+# A transfer from another account than the one of the path is not part of the batch
+def test_sign_tx_batch_wrong_signer(backend):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/1"
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_batch(path=path, transactions=[TRANSFER]):
+            pass
+
+    assert e.value.status == Errors.SW_INVALID_TRANSACTION
+
+
+# A batch must hold at least one transaction
+def test_sign_tx_batch_empty(backend):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_batch(path=path, transactions=[]):
+            pass
+
+    assert e.value.status == Errors.SW_BAD_STATE
@@ -0,0 +1,147 @@
+import hashlib
+import pytest
+
+from ragger.bip import pack_derivation_path
+from ragger.error import ExceptionRAPDU
+
+from application_client.boilerplate_command_sender import BoilerplateCommandSender, Errors, CLA, \
+    InsType, P1, P2
+from application_client.boilerplate_response_unpacker import unpack_get_public_key_response, unpack_sign_tx_response
+from utils import check_signature_validity, hex_to_bytes
+
+# In these tests the reviews of the transactions are queued: the upload is answered at once
+# and the signature is read afterwards with SIGN_TX_RESULT
+
+# ONT transferV2 of two transfer states from the account of m/44'/1024'/0'/0/0
+TRANSFER = hex_to_bytes("00d1744716e1c409000000000000204e000000000000ae6393b337e4a8d856ec00d75af134fdcd6bfe29af00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc8149b50e5a049679c32e4660266f8814001bde3e6fc6a7cc80210276a7cc86c00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc814e7f1d24e2d3bb7fa3051c732507ee74753756ff36a7cc80210276a7cc86c52c10a7472616e7366657256321400000000000000000000000000000000000000010068164f6e746f6c6f67792e4e61746976652e496e766f6b6500")
+
+
+def transfer_with_nonce(nonce: int) -> bytes:
+    return TRANSFER[:2] + nonce.to_bytes(4, byteorder="little") + TRANSFER[6:]
+
+
+def tx_hash(transaction: bytes) -> bytes:
+    return hashlib.sha256(hashlib.sha256(transaction).digest()).digest()
+
+
+# The second transaction is uploaded while the first one is reviewed,
+# and is reviewed as soon as the first one is approved
+def test_sign_tx_queued(backend, firmware, scenario_navigator, test_name):
+    if firmware.is_nano:
+        pytest.skip("Nano devices do not keep a staging slot")
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    first = transfer_with_nonce(1)
+    second = transfer_with_nonce(2)
+    assert len(client.sign_tx_queued(path=path, transaction=first).data) == 0
+
+    # The first review has not been answered yet
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_result()
+    assert e.value.status == Errors.SW_REVIEW_PENDING
+
+    # The commands using the context would disturb the review, the others are answered
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.get_public_key(path=path)
+    assert e.value.status == Errors.SW_BAD_STATE
+    client.get_version()
+
+    assert len(client.sign_tx_queued(path=path, transaction=second).data) == 0
+
+    # A third transaction would exceed the queue
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_queued(path=path, transaction=transfer_with_nonce(3))
+    assert e.value.status == Errors.SW_BAD_STATE
+
+    # Each review has its own snapshots
+    scenario_navigator.review_approve(test_name=f"{test_name}_first")
+    scenario_navigator.review_approve(test_name=f"{test_name}_second")
+
+    for transaction in (first, second):
+        _, der_sig, _ = unpack_sign_tx_response(client.sign_tx_result().data)
+        assert check_signature_validity(public_key, der_sig, tx_hash(transaction))
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_result()
+    assert e.value.status == Errors.SW_BAD_STATE
+
+
+# The result of a refused queued transaction is the refusal
+def test_sign_tx_queued_refused(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    client.sign_tx_queued(path=path, transaction=TRANSFER)
+    scenario_navigator.review_reject()
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_result()
+    assert e.value.status == Errors.SW_DENY
+    assert len(e.value.data) == 0
+
+
+# A staged upload whose path is refused leaves no staging slot to receive the next chunks
+def test_sign_tx_queued_staging_bad_path(backend, firmware, scenario_navigator):
+    if firmware.is_nano:
+        pytest.skip("Nano devices do not keep a staging slot")
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    assert len(client.sign_tx_queued(path=path, transaction=TRANSFER).data) == 0
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        backend.exchange(cla=CLA,
+                         ins=InsType.SIGN_TX,
+                         p1=P1.P1_START,
+                         p2=P2.P2_MORE,
+                         data=pack_derivation_path("m/44'/60'/0'/0/0"))
+    assert e.value.status == Errors.SW_INVALID_PATH
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        backend.exchange(cla=CLA,
+                         ins=InsType.SIGN_TX,
+                         p1=P1.P1_START + 1,
+                         p2=P2.P2_QUEUE,
+                         data=transfer_with_nonce(2))
+    assert e.value.status == Errors.SW_BAD_STATE
+
+    # The displayed review is not disturbed
+    scenario_navigator.review_approve()
+    _, der_sig, _ = unpack_sign_tx_response(client.sign_tx_result().data)
+    assert check_signature_validity(public_key, der_sig, tx_hash(TRANSFER))
+
+
+# Without a staging slot, the next upload is refused until the queued review is answered
+def test_sign_tx_queued_no_staging(backend, firmware, scenario_navigator, test_name):
+    if not firmware.is_nano:
+        pytest.skip("Only Nano devices do not keep a staging slot")
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    first = transfer_with_nonce(1)
+    second = transfer_with_nonce(2)
+    assert len(client.sign_tx_queued(path=path, transaction=first).data) == 0
+
+    with pytest.raises(ExceptionRAPDU) as e:
+        client.sign_tx_queued(path=path, transaction=second)
+    assert e.value.status == Errors.SW_BAD_STATE
+
+    scenario_navigator.review_approve(test_name=f"{test_name}_first")
+    _, der_sig, _ = unpack_sign_tx_response(client.sign_tx_result().data)
+    assert check_signature_validity(public_key, der_sig, tx_hash(first))
+
+    # The queue is free again once the result is read
+    assert len(client.sign_tx_queued(path=path, transaction=second).data) == 0
+    scenario_navigator.review_approve(test_name=f"{test_name}_second")
+    _, der_sig, _ = unpack_sign_tx_response(client.sign_tx_result().data)
+    assert check_signature_validity(public_key, der_sig, tx_hash(second))
@@ -0,0 +1,95 @@
+import hashlib
+from typing import List, Optional
+import pytest
+
+from ragger.error import ExceptionRAPDU
+
+from application_client.boilerplate_command_sender import BoilerplateCommandSender, Errors
+from application_client.boilerplate_response_unpacker import unpack_get_public_key_response, \
+    unpack_sign_tx_response, unpack_sign_tx_batch_response
+from application_client.boilerplate_tx_template import template_header, template_literal, \
+    template_transfer_state, template_native_tail
+from utils import check_signature_validity, hex_to_bytes
+
+# In these tests the transactions are sent template encoded, the device rebuilds the raw bytes
+
+# ONT transferV2 of two transfer states from the account of m/44'/1024'/0'/0/0
+TRANSFER = hex_to_bytes("00d1744716e1c409000000000000204e000000000000ae6393b337e4a8d856ec00d75af134fdcd6bfe29af00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc8149b50e5a049679c32e4660266f8814001bde3e6fc6a7cc80210276a7cc86c00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc814e7f1d24e2d3bb7fa3051c732507ee74753756ff36a7cc80210276a7cc86c52c10a7472616e7366657256321400000000000000000000000000000000000000010068164f6e746f6c6f67792e4e61746976652e496e766f6b6500")
+PAYER = TRANSFER[22:42]
+RECIPIENTS = [hex_to_bytes("9b50e5a049679c32e4660266f8814001bde3e6fc"),
+              hex_to_bytes("e7f1d24e2d3bb7fa3051c732507ee74753756ff3")]
+AMOUNT = hex_to_bytes("021027")  # PUSHBYTES2 10000
+ONT_CONTRACT = 0x01
+
+
+def transfer_with_nonce(nonce: int) -> bytes:
+    return TRANSFER[:2] + nonce.to_bytes(4, byteorder="little") + TRANSFER[6:]
+
+
+# A transfer built like TRANSFER, as template operations. Without a payer, it repeats the last one.
+def encode_transfer(transaction: bytes, payer: Optional[bytes]) -> List[bytes]:
+    return [template_header(transaction[:22], payer),
+            template_literal(TRANSFER[42:43]),  # payload size
+            template_transfer_state(RECIPIENTS[0], AMOUNT),
+            template_transfer_state(RECIPIENTS[1], AMOUNT),
+            template_literal(hex_to_bytes("52c10a") + b"transferV2"),
+            template_native_tail(ONT_CONTRACT)]
+
+
+def tx_hash(transaction: bytes) -> bytes:
+    return hashlib.sha256(hashlib.sha256(transaction).digest()).digest()
+
+
+def test_sign_tx_template(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    ops = encode_transfer(TRANSFER, payer=PAYER)
+    assert len(b"".join(ops)) < len(TRANSFER)
+
+    with client.sign_tx_template(path=path, ops=ops):
+        scenario_navigator.review_approve()
+
+    # The signature is the one of the raw transaction
+    _, der_sig, _ = unpack_sign_tx_response(client.get_async_response().data)
+    assert check_signature_validity(public_key, der_sig, tx_hash(TRANSFER))
+
+
+# Only the first transaction of the batch holds the payer, the others repeat it
+def test_sign_tx_batch_template(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    nonces = range(3)
+    encoded = [encode_transfer(transfer_with_nonce(nonce), PAYER if nonce == 0 else None)
+               for nonce in nonces]
+    with client.sign_tx_batch_template(path=path, transactions=encoded):
+        scenario_navigator.review_approve()
+
+    signatures = unpack_sign_tx_batch_response(client.get_async_response().data)
+    assert len(signatures) == len(nonces)
+    for nonce, (_, der_sig, _) in zip(nonces, signatures):
+        assert check_signature_validity(public_key, der_sig, tx_hash(transfer_with_nonce(nonce)))
+
+
+def test_sign_tx_template_invalid(backend):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    # No payer to repeat
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_template(path=path, ops=encode_transfer(TRANSFER, payer=None)):
+            pass
+    assert e.value.status == Errors.SW_TX_PARSING_FAIL
+
+    # Unknown operation
+    with pytest.raises(ExceptionRAPDU) as e:
+        with client.sign_tx_template(path=path, ops=[bytes([0x04])]):
+            pass
+    assert e.value.status == Errors.SW_TX_PARSING_FAIL
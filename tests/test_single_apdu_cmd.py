@@ -0,0 +1,45 @@
+import hashlib
+
+from application_client.boilerplate_personal_msg import PersonalMsg
+from application_client.boilerplate_command_sender import BoilerplateCommandSender
+from application_client.boilerplate_response_unpacker import unpack_get_public_key_response, \
+    unpack_sign_tx_response, unpack_sign_personal_msg_response
+from utils import check_signature_validity, checkpersonal_signature_validity, hex_to_bytes
+
+SIGN_MAGIC = b"\x19Ontology Signed Message:\n"
+
+# In these tests the derivation path and the whole payload are sent in a single APDU
+
+# ONT transferV2 of two transfer states from the account of m/44'/1024'/0'/0/0
+TRANSFER = hex_to_bytes("00d1744716e1c409000000000000204e000000000000ae6393b337e4a8d856ec00d75af134fdcd6bfe29af00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc8149b50e5a049679c32e4660266f8814001bde3e6fc6a7cc80210276a7cc86c00c66b14ae6393b337e4a8d856ec00d75af134fdcd6bfe296a7cc814e7f1d24e2d3bb7fa3051c732507ee74753756ff36a7cc80210276a7cc86c52c10a7472616e7366657256321400000000000000000000000000000000000000010068164f6e746f6c6f67792e4e61746976652e496e766f6b6500")
+
+
+def test_sign_tx_single_apdu(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    with client.sign_tx_single(path=path, transaction=TRANSFER):
+        scenario_navigator.review_approve()
+
+    _, der_sig, _ = unpack_sign_tx_response(client.get_async_response().data)
+    m_hash = hashlib.sha256(hashlib.sha256(TRANSFER).digest()).digest()
+    assert check_signature_validity(public_key, der_sig, m_hash)
+
+
+def test_sign_personal_msg_single_apdu(backend, scenario_navigator):
+    client = BoilerplateCommandSender(backend)
+    path: str = "m/44'/1024'/0'/0/0"
+
+    rapdu = client.get_public_key(path=path)
+    _, public_key, _, _ = unpack_get_public_key_response(rapdu.data)
+
+    personalmsg = PersonalMsg(personalmsg="test message").serialize()
+    with client.sign_personal_msg_single(path=path, personalmsg=personalmsg):
+        scenario_navigator.review_approve()
+
+    _, der_sig, _ = unpack_sign_personal_msg_response(client.get_async_response().data)
+    personalmsg = SIGN_MAGIC + str(len(personalmsg)).encode() + personalmsg
+    assert checkpersonal_signature_validity(public_key, der_sig, personalmsg)
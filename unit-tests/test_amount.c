@@ -0,0 +1,163 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "transaction/amount.h"
+
+static void test_amount_add(void **state) {
+    (void) state;
+
+    amount_t sum = {.high = 0, .low = UINT64_MAX};
+    amount_t one = {.high = 0, .low = 1};
+
+    // carry into the high word
+    assert_true(amount_add(&sum, &one));
+    assert_int_equal(sum.high, 1);
+    assert_int_equal(sum.low, 0);
+
+    // overflow of the high word, or of the carry, leaves the sum unchanged
+    amount_t max = {.high = UINT64_MAX, .low = UINT64_MAX};
+    assert_false(amount_add(&sum, &max));
+    assert_int_equal(sum.high, 1);
+    assert_int_equal(sum.low, 0);
+    assert_false(amount_add(&max, &one));
+    assert_int_equal(max.high, UINT64_MAX);
+    assert_int_equal(max.low, UINT64_MAX);
+}
+
+static void test_amount_mul(void **state) {
+    (void) state;
+
+    amount_t product;
+
+    amount_mul_u64(2500, 20000, &product);
+    assert_int_equal(product.high, 0);
+    assert_int_equal(product.low, 50000000);
+
+    // (2^64 - 1)^2 = 2^128 - 2^65 + 1
+    amount_mul_u64(UINT64_MAX, UINT64_MAX, &product);
+    assert_int_equal(product.high, UINT64_MAX - 1);
+    assert_int_equal(product.low, 1);
+
+    amount_mul_u64(1ULL << 32, 1ULL << 32, &product);
+    assert_int_equal(product.high, 1);
+    assert_int_equal(product.low, 0);
+}
+
+static void test_amount_to_chars(void **state) {
+    (void) state;
+
+    char out[64];
+    amount_t amount = {.high = 0, .low = 50000000};
+
+    assert_true(amount_to_chars(&amount, 9, out, sizeof(out)));
+    assert_string_equal(out, "0.05");
+    assert_true(amount_to_chars(&amount, 0, out, sizeof(out)));
+    assert_string_equal(out, "50000000");
+    assert_true(amount_to_chars(&amount, 7, out, sizeof(out)));
+    assert_string_equal(out, "5");
+
+    amount = (amount_t) {0};
+    assert_true(amount_to_chars(&amount, 18, out, sizeof(out)));
+    assert_string_equal(out, "0");
+
+    // 2^128 - 1
+    amount = (amount_t) {.high = UINT64_MAX, .low = UINT64_MAX};
+    assert_true(amount_to_chars(&amount, 18, out, sizeof(out)));
+    assert_string_equal(out, "340282366920938463463.374607431768211455");
+
+    // the buffer must hold the digits, the decimal point and the null terminator
+    assert_false(amount_to_chars(&amount, 18, out, 40));
+    assert_false(amount_to_chars(&amount, AMOUNT_MAX_DIGITS + 1, out, sizeof(out)));
+}
+
+// Reference formatting, one digit at a time with the compiler's 128-bit integers
+__extension__ typedef unsigned __int128 uint128_t;
+
+static void reference_to_chars(uint128_t value, uint8_t decimals, char *out) {
+    char digits[64];
+    size_t len = 0;
+    do {
+        digits[len++] = (char) ('0' + (int) (value % 10));
+        value /= 10;
+    } while (value != 0);
+    while (len <= decimals) {
+        digits[len++] = '0';
+    }
+
+    size_t skip = 0;
+    while (skip < decimals && digits[skip] == '0') {
+        skip++;
+    }
+    char *ptr = out;
+    for (size_t i = len; i > decimals; i--) {
+        *ptr++ = digits[i - 1];
+    }
+    if (skip < decimals) {
+        *ptr++ = '.';
+        for (size_t i = decimals; i > skip; i--) {
+            *ptr++ = digits[i - 1];
+        }
+    }
+    *ptr = '\0';
+}
+
+static void test_amount_to_chars_chunks(void **state) {
+    (void) state;
+
+    char out[64];
+    char expected[64];
+    const uint64_t chunk = 10000000000000000000ULL;
+    const amount_t amounts[] = {
+        {.high = 0, .low = chunk - 1},
+        {.high = 0, .low = chunk},
+        {.high = 0, .low = chunk + 1},
+        {.high = 0, .low = UINT64_MAX},
+        {.high = 1, .low = 0},
+        {.high = 5421010862427522170ULL, .low = 687399551400673280ULL},  // 10^38
+        {.high = 5421010862427522170ULL, .low = 687399551400673279ULL},  // 10^38 - 1
+        {.high = UINT64_MAX, .low = 0},
+    };
+
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    for (size_t k = 0; k < 200; k++) {
+        amount_t amount;
+        if (k < sizeof(amounts) / sizeof(amounts[0])) {
+            amount = amounts[k];
+        } else {
+            // xorshift, with the high word cleared to also cover small amounts
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            amount.low = seed;
+            amount.high = k % 3 == 0 ? 0 : seed * 31;
+        }
+        uint128_t value = ((uint128_t) amount.high << 64) | amount.low;
+        for (uint8_t decimals = 0; decimals <= AMOUNT_MAX_DIGITS; decimals += 3) {
+            reference_to_chars(value, decimals, expected);
+            assert_true(amount_to_chars(&amount, decimals, out, sizeof(out)));
+            assert_string_equal(out, expected);
+        }
+    }
+
+    // the trimmed string fits exactly
+    amount_t amount = {.high = 0, .low = 1500};
+    assert_true(amount_to_chars(&amount, 3, out, 4));
+    assert_string_equal(out, "1.5");
+    assert_false(amount_to_chars(&amount, 3, out, 3));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_amount_add),
+                                       cmocka_unit_test(test_amount_mul),
+                                       cmocka_unit_test(test_amount_to_chars),
+                                       cmocka_unit_test(test_amount_to_chars_chunks)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,84 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "base58.h"
+#include "address_base58.h"
+
+#define RANDOM_INPUTS 10000
+
+static uint64_t g_seed = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t xorshift64(void) {
+    g_seed ^= g_seed << 13;
+    g_seed ^= g_seed >> 7;
+    g_seed ^= g_seed << 17;
+    return g_seed;
+}
+
+static void check_same_encoding(const uint8_t in[static ADDRESS_BASE58_IN_LEN]) {
+    char expected[ADDRESS_BASE58_MAX_LEN + 1] = {0};
+    char actual[ADDRESS_BASE58_MAX_LEN + 1] = {0};
+
+    int expected_len = base58_encode(in, ADDRESS_BASE58_IN_LEN, expected, sizeof(expected));
+    int actual_len = address_base58_encode(in, actual, sizeof(actual));
+    assert_true(expected_len > 0);
+    assert_int_equal(actual_len, expected_len);
+    assert_memory_equal(actual, expected, (size_t) expected_len + 1);
+}
+
+static void test_address_base58_encode(void **state) {
+    (void) state;
+
+    // version byte, script hash 0x00..01, zero checksum
+    const uint8_t address[ADDRESS_BASE58_IN_LEN] = {
+        0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+    char out[ADDRESS_BASE58_MAX_LEN + 1] = {0};
+
+    check_same_encoding(address);
+    assert_int_equal(address_base58_encode(address, out, sizeof(out)), 34);
+    assert_string_equal(out, "AFmseVrdL9f9oyCzZefL9tG6UbvhTvwzRD");
+
+    // one byte short of the null terminator
+    assert_int_equal(address_base58_encode(address, out, 34), -1);
+
+    // all zeros, and all ones
+    uint8_t in[ADDRESS_BASE58_IN_LEN] = {0};
+    check_same_encoding(in);
+    assert_int_equal(address_base58_encode(in, out, sizeof(out)), ADDRESS_BASE58_IN_LEN);
+    memset(in, 0xff, sizeof(in));
+    check_same_encoding(in);
+    assert_int_equal(address_base58_encode(in, out, sizeof(out)), ADDRESS_BASE58_MAX_LEN);
+}
+
+static void test_address_base58_encode_random(void **state) {
+    (void) state;
+
+    uint8_t in[ADDRESS_BASE58_IN_LEN];
+    for (size_t n = 0; n < RANDOM_INPUTS; n++) {
+        for (size_t i = 0; i < sizeof(in); i++) {
+            in[i] = (uint8_t) xorshift64();
+        }
+        // Ontology version byte, then a varying number of leading zero bytes
+        if (n % 4 == 1) {
+            in[0] = 0x17;
+        } else if (n % 4 == 2) {
+            memset(in, 0, n / 4 % sizeof(in));
+        }
+        check_same_encoding(in);
+    }
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_address_base58_encode),
+                                       cmocka_unit_test(test_address_base58_encode_random)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,95 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "transaction/tx_types.h"
+#include "transaction/deserialize.h"
+#include "transaction/batch.h"
+
+// ONG transferV2 of 1 ONG, gas fee 0.05 ONG
+static const uint8_t ONG_TRANSFER[] = {
+    0x00, 0xd1, 0x15, 0xae, 0x02, 0xab, 0xc4, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x20, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9,
+    0xab, 0x73, 0xa1, 0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1,
+    0x7b, 0x00, 0xc6, 0x6b, 0x14, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9, 0xab, 0x73, 0xa1,
+    0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1, 0x6a, 0x7c, 0xc8,
+    0x14, 0x14, 0x51, 0x10, 0x84, 0x89, 0x33, 0x7c, 0x80, 0x55, 0xa9, 0xc1, 0xed, 0x91,
+    0x58, 0xc9, 0x47, 0xd2, 0x20, 0x70, 0xd7, 0x6a, 0x7c, 0xc8, 0x08, 0x00, 0x00, 0x64,
+    0xa7, 0xb3, 0xb6, 0xe0, 0x0d, 0x6a, 0x7c, 0xc8, 0x6c, 0x51, 0xc1, 0x0a, 0x74, 0x72,
+    0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x56, 0x32, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x68, 0x16, 0x4f, 0x6e, 0x74, 0x6f, 0x6c, 0x6f, 0x67, 0x79, 0x2e, 0x4e,
+    0x61, 0x74, 0x69, 0x76, 0x65, 0x2e, 0x49, 0x6e, 0x76, 0x6f, 0x6b, 0x65, 0x00};
+
+// MBL transfer on NeoVM
+static const uint8_t MBL_TRANSFER[] = {
+    0x00, 0xd1, 0xf2, 0xf9, 0x69, 0x05, 0xc4, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20,
+    0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x61, 0x79, 0x9f, 0x2c, 0x6b, 0xc9, 0xcd,
+    0x78, 0x51, 0x3b, 0x78, 0x4d, 0xd7, 0xb8, 0x59, 0x38, 0x6d, 0x8d, 0xb9, 0x51, 0x06, 0x40,
+    0x9b, 0x39, 0x86, 0x4c, 0x27, 0x14, 0x3a, 0xbd, 0xa2, 0x50, 0x87, 0x9a, 0xa3, 0x4d, 0xa0,
+    0xc5, 0x2e, 0xdd, 0xe2, 0x1d, 0x18, 0xdb, 0xca, 0x32, 0x3e, 0xfc, 0x14, 0x0b, 0x61, 0x79,
+    0x9f, 0x2c, 0x6b, 0xc9, 0xcd, 0x78, 0x51, 0x3b, 0x78, 0x4d, 0xd7, 0xb8, 0x59, 0x38, 0x6d,
+    0x8d, 0xb9, 0x53, 0xc1, 0x08, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x67, 0x6d,
+    0x03, 0xa1, 0x68, 0x43, 0xe6, 0x1e, 0x5d, 0x96, 0xd3, 0x89, 0xe1, 0x78, 0x71, 0x7e, 0xd5,
+    0x7f, 0x9d, 0xa4, 0xe5, 0x00};
+
+static void parse(const uint8_t *raw, size_t len, transaction_t *tx) {
+    buffer_t buf = {.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, tx), PARSING_OK);
+}
+
+static void test_batch_add_transaction(void **state) {
+    (void) state;
+
+    transaction_t tx;
+    tx_batch_t batch = {0};
+    memcpy(batch.signer, ONG_TRANSFER + 47, ADDRESS_SCRIPT_HASH_LEN);
+
+    parse(ONG_TRANSFER, sizeof(ONG_TRANSFER), &tx);
+    assert_true(batch_add_transaction(&batch, &tx));
+    assert_int_equal(batch.tx_count, 1);
+    assert_int_equal(batch.tokens_num, 1);
+    assert_string_equal(batch.tokens[0].ticker, "ONG");
+    assert_int_equal(batch.tokens[0].total.high, 0);
+    assert_int_equal(batch.tokens[0].total.low, 1000000000000000000ULL);
+    assert_int_equal(batch.gas.low, 50000000);
+    assert_int_equal(batch.recipients_num, 1);
+    assert_memory_equal(batch.recipients[0], ONG_TRANSFER + 71, ADDRESS_SCRIPT_HASH_LEN);
+
+    // the same recipient is counted once
+    assert_true(batch_add_transaction(&batch, &tx));
+    assert_int_equal(batch.tx_count, 2);
+    assert_int_equal(batch.recipients_num, 1);
+    assert_int_equal(batch.tokens[0].total.low, 2000000000000000000ULL);
+    assert_int_equal(batch.gas.low, 100000000);
+
+    // a transfer from another account leaves the summary unchanged
+    tx_batch_t before = batch;
+    parse(MBL_TRANSFER, sizeof(MBL_TRANSFER), &tx);
+    assert_false(batch_add_transaction(&batch, &tx));
+    assert_memory_equal(&batch, &before, sizeof(batch));
+
+    // a second token, from its own signer
+    memcpy(batch.signer, MBL_TRANSFER + 22, ADDRESS_SCRIPT_HASH_LEN);
+    assert_true(batch_add_transaction(&batch, &tx));
+    assert_int_equal(batch.tokens_num, 2);
+    assert_string_equal(batch.tokens[1].ticker, "MBL");
+    assert_int_equal(batch.recipients_num, 2);
+    assert_memory_equal(batch.recipients[1], MBL_TRANSFER + 51, ADDRESS_SCRIPT_HASH_LEN);
+
+    // the batch is full
+    batch.tx_count = BATCH_TX_MAX_NUM;
+    assert_false(batch_add_transaction(&batch, &tx));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_batch_add_transaction)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,70 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "transaction/contract.h"
+
+static void test_contract_registry_sorted(void **state) {
+    (void) state;
+
+    for (size_t i = 0; i < PREDEFINED_PAYLOADS_NUM; i++) {
+        const payload_t *payload = &PREDEFINED_PAYLOADS[i];
+        if (i > 0) {
+            assert_true(memcmp(PREDEFINED_PAYLOADS[i - 1].contract_addr,
+                               payload->contract_addr,
+                               ADDRESS_SCRIPT_HASH_LEN) < 0);
+        }
+        for (size_t j = 0; j < payload->methods_num; j++) {
+            const tx_method_signature_t *method = &payload->methods[j];
+            assert_int_equal(method->name_len, strlen(method->name));
+            assert_non_null(method->parse_params);
+            if (j > 0) {
+                const tx_method_signature_t *prev = &payload->methods[j - 1];
+                assert_true(prev->name_len < method->name_len ||
+                            (prev->name_len == method->name_len &&
+                             memcmp(prev->name, method->name, method->name_len) < 0));
+            }
+        }
+    }
+}
+
+static void test_contract_registry_lookup(void **state) {
+    (void) state;
+
+    for (size_t i = 0; i < PREDEFINED_PAYLOADS_NUM; i++) {
+        const payload_t *payload = &PREDEFINED_PAYLOADS[i];
+        assert_ptr_equal(find_tx_payload(payload->contract_addr), payload);
+        for (size_t j = 0; j < payload->methods_num; j++) {
+            const tx_method_signature_t *method = &payload->methods[j];
+            assert_ptr_equal(
+                find_tx_method(payload, (const uint8_t *) method->name, method->name_len),
+                method);
+        }
+    }
+
+    uint8_t unknown_addr[ADDRESS_SCRIPT_HASH_LEN] = {0};
+    assert_null(find_tx_payload(unknown_addr));
+    memset(unknown_addr, 0xff, sizeof(unknown_addr));
+    assert_null(find_tx_payload(unknown_addr));
+
+    const payload_t *ont = find_tx_payload((const uint8_t *) ONT_ADDR);
+    assert_non_null(ont);
+    assert_string_equal(ont->ticker, ONT_TICKER);
+    assert_null(find_tx_method(ont, (const uint8_t *) "transfe", 7));
+    assert_null(find_tx_method(ont,
+                               (const uint8_t *) METHOD_REGISTER_CANDIDATE,
+                               strlen(METHOD_REGISTER_CANDIDATE)));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_contract_registry_sorted),
+                                       cmocka_unit_test(test_contract_registry_lookup)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,163 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "transaction/neovm.h"
+
+static void test_neovm_push_tokens(void **state) {
+    (void) state;
+
+    // PUSH0, PUSH16, PUSHBYTES2, PUSHDATA1, PUSHDATA2
+    uint8_t code[] = {0x00, 0x60, 0x02, 0xaa, 0xbb, 0x4c, 0x01, 0xcc, 0x4d, 0x02, 0x00, 0xdd, 0xee};
+    buffer_t buf = {.ptr = code, .size = sizeof(code), .offset = 0};
+    neovm_token_t token;
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_PUSH_INT);
+    assert_int_equal(token.value, 0);
+    assert_int_equal(token.len, 1);
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_PUSH_INT);
+    assert_int_equal(token.value, 16);
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_PUSH_BYTES);
+    assert_int_equal(token.offset, 2);
+    assert_int_equal(token.data_offset, 3);
+    assert_int_equal(token.data_len, 2);
+    assert_int_equal(token.len, 3);
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_PUSH_BYTES);
+    assert_int_equal(token.data_offset, 7);
+    assert_int_equal(token.data_len, 1);
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_PUSH_BYTES);
+    assert_int_equal(token.data_offset, 11);
+    assert_int_equal(token.data_len, 2);
+    assert_int_equal(token.len, 5);
+
+    assert_int_equal(buf.offset, sizeof(code));
+    assert_false(neovm_read_token(&buf, &token));
+}
+
+static void test_neovm_call_tokens(void **state) {
+    (void) state;
+
+    uint8_t code[1 + 20 + 1 + 1 + 22 + 1 + 1 + 3];
+    size_t len = 0;
+    code[len++] = 0x67;  // APPCALL
+    memset(code + len, 0x11, 20);
+    len += 20;
+    code[len++] = 0x68;  // SYSCALL
+    code[len++] = 22;
+    memcpy(code + len, "Ontology.Native.Invoke", 22);
+    len += 22;
+    code[len++] = 0xc1;  // PACK
+    code[len++] = 0xc6;  // NEWSTRUCT
+    code[len++] = 0x62;  // JMP
+    code[len++] = 0x01;
+    code[len++] = 0x00;
+
+    buffer_t buf = {.ptr = code, .size = len, .offset = 0};
+    neovm_token_t token;
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_APPCALL);
+    assert_int_equal(token.data_offset, 1);
+    assert_int_equal(token.len, 21);
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_SYSCALL);
+    assert_int_equal(token.data_len, 22);
+    assert_memory_equal(code + token.data_offset, "Ontology.Native.Invoke", 22);
+
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_PACK);
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_NEWSTRUCT);
+    assert_true(neovm_read_token(&buf, &token));
+    assert_int_equal(token.type, NEOVM_TOKEN_OPCODE);
+    assert_int_equal(token.len, 3);
+}
+
+static void test_neovm_truncated_tokens(void **state) {
+    (void) state;
+
+    // the operand length is known but the data has not been received
+    uint8_t pushdata2[] = {0x4d, 0x00, 0x01, 0xaa};
+    buffer_t buf = {.ptr = pushdata2, .size = sizeof(pushdata2), .offset = 0};
+    neovm_token_t token;
+
+    assert_true(neovm_decode_token(&buf, &token));
+    assert_int_equal(token.len, 3 + 256);
+    assert_false(neovm_read_token(&buf, &token));
+    assert_int_equal(buf.offset, 0);
+
+    // the operand length itself is missing
+    buf.size = 2;
+    assert_false(neovm_decode_token(&buf, &token));
+}
+
+static void test_neovm_read_opcodes(void **state) {
+    (void) state;
+
+    const uint8_t param_end[] = {0x6a, 0x7c, 0xc8};
+    uint8_t code[] = {0x6a, 0x7c, 0xc8, 0x6a, 0x03, 0x7c, 0xc8, 0xc8};
+    buffer_t buf = {.ptr = code, .size = sizeof(code), .offset = 0};
+
+    assert_true(neovm_read_opcodes(&buf, param_end, sizeof(param_end)));
+    assert_int_equal(buf.offset, 3);
+
+    // 0x03 is a push whose data happens to match, it must not be mistaken for the opcodes
+    assert_false(neovm_read_opcodes(&buf, param_end, sizeof(param_end)));
+    assert_int_equal(buf.offset, 3);
+}
+
+static void test_neovm_match_template(void **state) {
+    (void) state;
+
+    // PUSHBYTES2 <any> 6a7cc8, over more than a word
+    const uint8_t bytes[] = {0x02, 0x00, 0x00, 0x6a, 0x7c, 0xc8, 0x6a, 0x7c, 0xc8, 0x6c};
+    const uint8_t mask[] = {0xff, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    uint8_t code[] = {0x02, 0xaa, 0xbb, 0x6a, 0x7c, 0xc8, 0x6a, 0x7c, 0xc8, 0x6c, 0x00};
+    buffer_t buf = {.ptr = code, .size = sizeof(code), .offset = 0};
+
+    assert_true(neovm_match_template(&buf, bytes, mask, sizeof(bytes)));
+    assert_int_equal(buf.offset, sizeof(bytes));
+
+    // the wildcard bytes must be equal without the mask
+    buf.offset = 0;
+    assert_false(neovm_match_template(&buf, bytes, NULL, sizeof(bytes)));
+    assert_int_equal(buf.offset, 0);
+
+    // a difference in the last word or in the tail
+    code[8] = 0xc9;
+    assert_false(neovm_match_template(&buf, bytes, mask, sizeof(bytes)));
+    code[8] = 0xc8;
+    code[9] = 0x6d;
+    assert_false(neovm_match_template(&buf, bytes, mask, sizeof(bytes)));
+
+    // not enough bytes
+    code[9] = 0x6c;
+    buf.size = sizeof(bytes) - 1;
+    assert_false(neovm_match_template(&buf, bytes, mask, sizeof(bytes)));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_neovm_push_tokens),
+                                       cmocka_unit_test(test_neovm_call_tokens),
+                                       cmocka_unit_test(test_neovm_truncated_tokens),
+                                       cmocka_unit_test(test_neovm_read_opcodes),
+                                       cmocka_unit_test(test_neovm_match_template)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,160 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "crypto_helpers.h"
+#include "pubkey_cache.h"
+
+#define H 0x80000000U
+
+// The crypto is mocked: the tests count the derivations in the secure element, which must
+// only happen for the hardened levels
+static int se_calls;
+static int hmac_calls;
+static bool hmac_fails;
+
+cx_err_t bip32_derive_with_seed_get_pubkey_256(unsigned int derivation_mode,
+                                               cx_curve_t curve,
+                                               const uint32_t *path,
+                                               size_t path_len,
+                                               uint8_t raw_pubkey[static 65],
+                                               uint8_t *chain_code,
+                                               cx_md_t hashID,
+                                               unsigned char *seed_key,
+                                               unsigned int seed_key_length) {
+    (void) derivation_mode;
+    (void) curve;
+    (void) hashID;
+    (void) seed_key;
+    (void) seed_key_length;
+
+    se_calls++;
+    memset(raw_pubkey, 0, 65);
+    raw_pubkey[0] = 0x04;
+    raw_pubkey[1] = (uint8_t) path_len;
+    raw_pubkey[2] = (uint8_t) path[path_len - 1];
+    memset(chain_code, (int) path_len, 32);
+    return CX_OK;
+}
+
+// Like the SDK, the length of the MAC is returned
+size_t cx_hmac_sha512(const uint8_t *key,
+                      size_t key_len,
+                      const uint8_t *in,
+                      size_t len,
+                      uint8_t *mac,
+                      size_t mac_len) {
+    (void) key;
+    (void) key_len;
+
+    hmac_calls++;
+    if (hmac_fails) {
+        return 0;
+    }
+    memset(mac, 0, mac_len);
+    mac[31] = 1;            // I_L, a valid scalar
+    mac[32] = in[len - 1];  // I_R, the chain code of the child
+    return mac_len;
+}
+
+cx_err_t cx_ecfp_scalar_mult_no_throw(cx_curve_t curve, uint8_t *P, const uint8_t *k, size_t k_len) {
+    (void) curve;
+    (void) P;
+    (void) k;
+    (void) k_len;
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_add_point_no_throw(cx_curve_t curve,
+                                    uint8_t *R,
+                                    const uint8_t *P,
+                                    const uint8_t *Q) {
+    (void) curve;
+    (void) P;
+    memcpy(R, Q, 65);
+    R[64]++;
+    return CX_OK;
+}
+
+bool compress_public_key(const uint8_t uncompressed_key[static UNCOMPRESSED_KEY_LEN],
+                         uint8_t compressed_key[static COMPRESSED_KEY_LEN]) {
+    memcpy(compressed_key, uncompressed_key, COMPRESSED_KEY_LEN);
+    return true;
+}
+
+static void reset(void) {
+    pubkey_cache_clear();
+    se_calls = 0;
+    hmac_calls = 0;
+    hmac_fails = false;
+}
+
+static void test_pubkey_cache_public_derivation(void **state) {
+    (void) state;
+
+    reset();
+    uint8_t key[UNCOMPRESSED_KEY_LEN];
+    uint8_t chain_code[CHAIN_CODE_LEN];
+
+    // The account is derived in the secure element, the 2 levels below it publicly
+    uint32_t path[5] = {44 | H, 1024 | H, 0 | H, 0, 0};
+    assert_int_equal(pubkey_cache_get(path, 5, key, chain_code), CX_OK);
+    assert_int_equal(se_calls, 1);
+    assert_int_equal(hmac_calls, 2);
+    assert_int_equal(key[64], 2);
+    assert_int_equal(chain_code[0], 0);
+
+    // The other addresses of the account only derive their last level
+    for (uint32_t i = 1; i < 5; i++) {
+        path[4] = i;
+        assert_int_equal(pubkey_cache_get(path, 5, key, chain_code), CX_OK);
+        assert_int_equal(chain_code[0], i);
+    }
+    assert_int_equal(se_calls, 1);
+    assert_int_equal(hmac_calls, 6);
+
+    // A cached path is copied
+    assert_int_equal(pubkey_cache_get(path, 5, key, NULL), CX_OK);
+    assert_int_equal(se_calls, 1);
+    assert_int_equal(hmac_calls, 6);
+
+    // A deep path goes down from its last hardened level in a loop
+    uint32_t deep[10] = {44 | H, 1024 | H, 0x7fffffff, 0, 0, 0, 0, 0, 0, 0};
+    assert_int_equal(pubkey_cache_get(deep, 10, key, NULL), CX_OK);
+    assert_int_equal(se_calls, 2);
+    assert_int_equal(hmac_calls, 14);
+}
+
+static void test_pubkey_cache_fallback(void **state) {
+    (void) state;
+
+    reset();
+    uint8_t key[UNCOMPRESSED_KEY_LEN];
+
+    // A hardened leaf is always derived in the secure element
+    uint32_t hardened[3] = {44 | H, 1024 | H, 1 | H};
+    assert_int_equal(pubkey_cache_get(hardened, 3, key, NULL), CX_OK);
+    assert_int_equal(se_calls, 1);
+    assert_int_equal(hmac_calls, 0);
+
+    // When the public derivation fails, each level is derived in the secure element
+    hmac_fails = true;
+    uint32_t path[5] = {44 | H, 1024 | H, 1 | H, 0, 0};
+    assert_int_equal(pubkey_cache_get(path, 5, key, NULL), CX_OK);
+    assert_int_equal(se_calls, 3);
+    assert_int_equal(key[1], 5);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_pubkey_cache_public_derivation),
+        cmocka_unit_test(test_pubkey_cache_fallback)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
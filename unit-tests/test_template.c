@@ -0,0 +1,137 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "transaction/tx_types.h"
+#include "transaction/template.h"
+
+// ONG transferV2 of 1 ONG, gas fee 0.05 ONG
+static const uint8_t ONG_TRANSFER[] = {
+    0x00, 0xd1, 0x15, 0xae, 0x02, 0xab, 0xc4, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x20, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9,
+    0xab, 0x73, 0xa1, 0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1,
+    0x7b, 0x00, 0xc6, 0x6b, 0x14, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9, 0xab, 0x73, 0xa1,
+    0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1, 0x6a, 0x7c, 0xc8,
+    0x14, 0x14, 0x51, 0x10, 0x84, 0x89, 0x33, 0x7c, 0x80, 0x55, 0xa9, 0xc1, 0xed, 0x91,
+    0x58, 0xc9, 0x47, 0xd2, 0x20, 0x70, 0xd7, 0x6a, 0x7c, 0xc8, 0x08, 0x00, 0x00, 0x64,
+    0xa7, 0xb3, 0xb6, 0xe0, 0x0d, 0x6a, 0x7c, 0xc8, 0x6c, 0x51, 0xc1, 0x0a, 0x74, 0x72,
+    0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x56, 0x32, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x68, 0x16, 0x4f, 0x6e, 0x74, 0x6f, 0x6c, 0x6f, 0x67, 0x79, 0x2e, 0x4e,
+    0x61, 0x74, 0x69, 0x76, 0x65, 0x2e, 0x49, 0x6e, 0x76, 0x6f, 0x6b, 0x65, 0x00};
+
+// Encode ONG_TRANSFER, the from of the transfer state repeating the payer
+static size_t encode_ong_transfer(uint8_t *encoded) {
+    size_t len = 0;
+    encoded[len++] = TX_TEMPLATE_HEADER;
+    encoded[len++] = 0;
+    memcpy(encoded + len, ONG_TRANSFER, TX_HEADER_LEN);
+    len += TX_HEADER_LEN;
+    encoded[len++] = TX_TEMPLATE_LITERAL;
+    encoded[len++] = 1;
+    encoded[len++] = ONG_TRANSFER[42];  // payload size
+    encoded[len++] = TX_TEMPLATE_TRANSFER_STATE;
+    encoded[len++] = TX_TEMPLATE_REPEAT_ADDRESS;
+    memcpy(encoded + len, ONG_TRANSFER + 71, 20);  // to
+    len += 20;
+    memcpy(encoded + len, ONG_TRANSFER + 94, 9);  // amount, PUSHBYTES8
+    len += 9;
+    encoded[len++] = TX_TEMPLATE_LITERAL;
+    encoded[len++] = 13;
+    memcpy(encoded + len, ONG_TRANSFER + 107, 13);  // PUSH1 PACK "transferV2"
+    len += 13;
+    encoded[len++] = TX_TEMPLATE_NATIVE_TAIL;
+    encoded[len++] = 0x02;
+    return len;
+}
+
+static void test_template_decode(void **state) {
+    (void) state;
+
+    uint8_t encoded[128];
+    size_t encoded_len = encode_ong_transfer(encoded);
+    assert_true(encoded_len < sizeof(ONG_TRANSFER));
+
+    tx_template_t ctx = {0};
+    uint8_t raw_tx[sizeof(ONG_TRANSFER)];
+    size_t raw_tx_len = 0;
+    buffer_t buf = {.ptr = encoded, .size = encoded_len, .offset = 0};
+
+    assert_true(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    assert_int_equal(raw_tx_len, sizeof(ONG_TRANSFER));
+    assert_memory_equal(raw_tx, ONG_TRANSFER, sizeof(ONG_TRANSFER));
+    assert_memory_equal(ctx.address, ONG_TRANSFER + 22, 20);
+
+    // the same operations split between two uploads, the header in the first one
+    raw_tx_len = 0;
+    memset(&ctx, 0, sizeof(ctx));
+    buf = (buffer_t){.ptr = encoded, .size = 2 + TX_HEADER_LEN, .offset = 0};
+    assert_true(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    assert_int_equal(raw_tx_len, TX_HEADER_LEN);
+    buf = (buffer_t){.ptr = encoded + 2 + TX_HEADER_LEN,
+                     .size = encoded_len - 2 - TX_HEADER_LEN,
+                     .offset = 0};
+    assert_true(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    assert_memory_equal(raw_tx, ONG_TRANSFER, sizeof(ONG_TRANSFER));
+}
+
+static void test_template_decode_errors(void **state) {
+    (void) state;
+
+    uint8_t encoded[128];
+    size_t encoded_len = encode_ong_transfer(encoded);
+    uint8_t raw_tx[sizeof(ONG_TRANSFER)];
+    tx_template_t ctx = {0};
+    size_t raw_tx_len = 0;
+
+    // no address to repeat before the header
+    buffer_t buf = {.ptr = encoded + 2 + TX_HEADER_LEN,
+                    .size = encoded_len - 2 - TX_HEADER_LEN,
+                    .offset = 0};
+    assert_false(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    assert_int_equal(raw_tx_len, 0);
+
+    // the rebuilt bytes do not fit
+    buf = (buffer_t){.ptr = encoded, .size = encoded_len, .offset = 0};
+    assert_false(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx) - 1, &raw_tx_len));
+    assert_int_equal(raw_tx_len, 0);
+
+    // an operation cut in the middle
+    buf = (buffer_t){.ptr = encoded, .size = encoded_len - 1, .offset = 0};
+    assert_false(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+
+    // unknown flags and operations
+    encoded[1] = 0x02;
+    buf = (buffer_t){.ptr = encoded, .size = encoded_len, .offset = 0};
+    assert_false(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    encoded[1] = 0;
+    encoded[0] = 0x04;
+    buf.offset = 0;
+    assert_false(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+
+    // the amount of a transfer state must be a push
+    uint8_t transfer_state[] = {TX_TEMPLATE_TRANSFER_STATE, TX_TEMPLATE_REPEAT_ADDRESS,
+                                0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                0xc1};
+    ctx.has_address = true;
+    buf = (buffer_t){.ptr = transfer_state, .size = sizeof(transfer_state), .offset = 0};
+    assert_false(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    transfer_state[sizeof(transfer_state) - 1] = 0x5a;  // PUSH10
+    buf.offset = 0;
+    assert_true(tx_template_decode(&ctx, &buf, raw_tx, sizeof(raw_tx), &raw_tx_len));
+    assert_int_equal(raw_tx_len, 3 + 21 + 3 + 21 + 3 + 1 + 4);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_template_decode),
+                                       cmocka_unit_test(test_template_decode_errors)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -10,6 +10,7 @@
 
 #include "transaction/deserialize.h"
 #include "transaction/parse.h"
+#include "transaction/utils.h"
 
 
 static void test_tx_gov_withdraw_parser(void **state) {
@@ -39,6 +40,7 @@ static void test_tx_gov_withdraw_parser(void **state) {
     parser_status_e status_tx = transaction_deserialize(&buf, &tx);
 
     assert_int_equal(status_tx, PARSING_OK);
+    assert_int_equal(tx.method.id, METHOD_ID_WITHDRAW);
 }
 
 static void test_tx_ont_transferv2_parser(void **state) {
@@ -346,6 +348,10 @@ static void test_tx_native_transfer_parser(void **state) {
     parser_status_e status_tx = transaction_deserialize(&buf, &tx);
 
     assert_int_equal(status_tx, PARSING_OK);
+    assert_int_equal(tx.contract.type, NATIVE_CONTRACT);
+    assert_int_equal(tx.method.name.len, strlen("transferV2"));
+    assert_memory_equal(hex_array + tx.method.name.offset, "transferV2", tx.method.name.len);
+    assert_int_equal(tx.method.id, METHOD_ID_TRANSFER_V2);
 }
 
 static void test_tx_neo_oep4_transfer_parser(void **state) {
@@ -368,6 +374,29 @@ static void test_tx_neo_oep4_transfer_parser(void **state) {
     parser_status_e status_tx = transaction_deserialize(&buf, &tx);
 
     assert_int_equal(status_tx, PARSING_OK);
+    assert_int_equal(tx.contract.type, NEOVM_CONTRACT);
+    assert_int_equal(tx.method.name.len, strlen("transfer"));
+    assert_memory_equal(hex_array + tx.method.name.offset, "transfer", tx.method.name.len);
+    assert_int_equal(tx.method.id, METHOD_ID_TRANSFER);
+
+    // the same amount pushed with PUSHDATA1 instead of PUSHBYTES6
+    uint64_t amount = 0;
+    uint64_t pushdata_amount = 0;
+    assert_int_equal(tx.method.parameters[0].type, PARAM_AMOUNT);
+    assert_true(convert_param_to_uint64_le(hex_array, &tx.method.parameters[0], &amount));
+
+    uint8_t pushdata_array[sizeof(hex_array) + 1];
+    memcpy(pushdata_array, hex_array, 43);
+    pushdata_array[42] = hex_array[42] + 1;
+    pushdata_array[43] = OPCODE_PUSHDATA1;
+    memcpy(pushdata_array + 44, hex_array + 43, sizeof(hex_array) - 43);
+    buf = (buffer_t){.ptr = pushdata_array, .size = sizeof(pushdata_array), .offset = 0};
+
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.method.id, METHOD_ID_TRANSFER);
+    assert_true(
+        convert_param_to_uint64_le(pushdata_array, &tx.method.parameters[0], &pushdata_amount));
+    assert_int_equal(pushdata_amount, amount);
 }
 
 static void test_tx_wasm_oep4_transfer_parser(void **state) {
@@ -391,6 +420,39 @@ static void test_tx_wasm_oep4_transfer_parser(void **state) {
     parser_status_e status_tx = transaction_deserialize(&buf, &tx);
 
     assert_int_equal(status_tx, PARSING_OK);
+    assert_int_equal(tx.contract.type, WASMVM_CONTRACT);
+    assert_int_equal(tx.method.id, METHOD_ID_TRANSFER);
+    assert_int_equal(tx.method.parameters[2].type, PARAM_UINT128);
+
+    // the remaining length must use the shortest varuint encoding
+    uint8_t long_array[1024];
+    memcpy(long_array, hex_array, 42);
+    long_array[42] = hex_array[42] + 2;
+    memcpy(long_array + 43, hex_array + 43, 20);
+    long_array[63] = 0xfd;
+    long_array[64] = hex_array[63];
+    long_array[65] = 0x00;
+    memcpy(long_array + 66, hex_array + 64, sizeof(hex_array) - 64);
+    buf = (buffer_t){.ptr = long_array, .size = sizeof(hex_array) + 2, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_BYTECODE_WRONG);
+
+    // arguments longer than 255 bytes, for a method which is not registered
+    const char method[] = "batchTransfer";
+    const size_t args_len = 1 + sizeof(method) - 1 + 400;
+    const size_t payload_len = 20 + 3 + args_len;
+    long_array[42] = 0xfd;
+    long_array[43] = payload_len & 0xff;
+    long_array[44] = payload_len >> 8;
+    memcpy(long_array + 45, hex_array + 43, 20);
+    long_array[65] = 0xfd;
+    long_array[66] = args_len & 0xff;
+    long_array[67] = args_len >> 8;
+    long_array[68] = sizeof(method) - 1;
+    memcpy(long_array + 69, method, sizeof(method) - 1);
+    memset(long_array + 69 + sizeof(method) - 1, 0x42, 400);
+    long_array[45 + payload_len] = 0x00;
+    buf = (buffer_t){.ptr = long_array, .size = 45 + payload_len + 1, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_TX_NOT_DEFINED);
 }
 
 static void test_tx_error_parser(void **state) {
@@ -439,6 +501,376 @@ static void test_tx_note_defined_parser(void **state) {
     assert_int_equal(status_tx, PARSING_TX_NOT_DEFINED);
 }
 
+// Feed `hex_array` to the resumable parser `chunk_len` bytes at a time, as SIGN_TX APDUs do.
+// Stop at the first chunk the parser rejects and return its status.
+static parser_status_e feed_in_chunks(uint8_t *hex_array,
+                                      size_t len,
+                                      size_t chunk_len,
+                                      transaction_t *tx) {
+    tx_parser_t parser;
+    transaction_parser_init(&parser);
+
+    size_t received = 0;
+    parser_status_e status = PARSING_OK;
+    while (status == PARSING_OK && received < len) {
+        received = (len - received > chunk_len) ? received + chunk_len : len;
+        buffer_t buf = {.ptr = hex_array, .size = received, .offset = 0};
+        status = transaction_parser_feed(&parser, &buf, received == len, tx);
+    }
+    return status;
+}
+
+static void test_tx_chunked_parser(void **state) {
+    (void) state;
+
+    transaction_t tx;
+    transaction_t tx_chunked;
+
+    uint8_t hex_array[] = {
+        0x00, 0xd1, 0x15, 0xae, 0x02, 0xab, 0xc4, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9,
+        0xab, 0x73, 0xa1, 0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1,
+        0x7b, 0x00, 0xc6, 0x6b, 0x14, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9, 0xab, 0x73, 0xa1,
+        0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1, 0x6a, 0x7c, 0xc8,
+        0x14, 0x14, 0x51, 0x10, 0x84, 0x89, 0x33, 0x7c, 0x80, 0x55, 0xa9, 0xc1, 0xed, 0x91,
+        0x58, 0xc9, 0x47, 0xd2, 0x20, 0x70, 0xd7, 0x6a, 0x7c, 0xc8, 0x08, 0x00, 0x00, 0x64,
+        0xa7, 0xb3, 0xb6, 0xe0, 0x0d, 0x6a, 0x7c, 0xc8, 0x6c, 0x51, 0xc1, 0x0a, 0x74, 0x72,
+        0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x56, 0x32, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x68, 0x16, 0x4f, 0x6e, 0x74, 0x6f, 0x6c, 0x6f, 0x67, 0x79, 0x2e, 0x4e,
+        0x61, 0x74, 0x69, 0x76, 0x65, 0x2e, 0x49, 0x6e, 0x76, 0x6f, 0x6b, 0x65, 0x00};
+
+    buffer_t buf = {.ptr = hex_array, .size = sizeof(hex_array), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+
+    const size_t chunk_lens[] = {1, 7, 42, 43, 255};
+    for (size_t i = 0; i < sizeof(chunk_lens) / sizeof(chunk_lens[0]); i++) {
+        memset(&tx_chunked, 0, sizeof(tx_chunked));
+        assert_int_equal(feed_in_chunks(hex_array, sizeof(hex_array), chunk_lens[i], &tx_chunked),
+                         PARSING_OK);
+        assert_int_equal(tx_chunked.contract.type, tx.contract.type);
+        assert_int_equal(tx_chunked.method.name.len, tx.method.name.len);
+        assert_int_equal(tx_chunked.method.name.offset, tx.method.name.offset);
+        assert_int_equal(tx_chunked.method.parameters[0].offset, tx.method.parameters[0].offset);
+        assert_int_equal(tx_chunked.method.parameters[0].len, tx.method.parameters[0].len);
+    }
+}
+
+static void test_tx_chunked_error_parser(void **state) {
+    (void) state;
+
+    transaction_t tx;
+    tx_parser_t parser;
+
+    uint8_t hex_array[] = {
+        0x00, 0xd1, 0x15, 0xae, 0x02, 0xab, 0xc4, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9,
+        0xab, 0x73, 0xa1, 0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1,
+        0x7b, 0x00, 0xc6, 0x6b, 0x14, 0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9, 0xab, 0x73, 0xa1,
+        0x75, 0xec, 0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1, 0x6a, 0x7c, 0xc8,
+        0x14, 0x14, 0x51, 0x10, 0x84, 0x89, 0x33, 0x7c, 0x80, 0x55, 0xa9, 0xc1, 0xed, 0x91,
+        0x58, 0xc9, 0x47, 0xd2, 0x20, 0x70, 0xd7, 0x6a, 0x7c, 0xc8, 0x08, 0x00, 0x00, 0x64,
+        0xa7, 0xb3, 0xb6, 0xe0, 0x0d, 0x6a, 0x7c, 0xc8, 0x6c, 0x51, 0xc1, 0x0a, 0x74, 0x72,
+        0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x56, 0x32, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x68, 0x16, 0x4f, 0x6e, 0x74, 0x6f, 0x6c, 0x6f, 0x67, 0x79, 0x2e, 0x4e,
+        0x61, 0x74, 0x69, 0x76, 0x65, 0x2e, 0x49, 0x6e, 0x76, 0x6f, 0x6b, 0x65, 0x00};
+
+    // gasPrice below the minimum is rejected as soon as the header has arrived
+    uint8_t gas_price = hex_array[6];
+    hex_array[6] = 0x00;
+    hex_array[7] = 0x00;
+    transaction_parser_init(&parser);
+    buffer_t buf = {.ptr = hex_array, .size = 50, .offset = 0};
+    assert_int_equal(transaction_parser_feed(&parser, &buf, false, &tx), PARSING_BYTECODE_WRONG);
+    hex_array[6] = gas_price;
+    hex_array[7] = 0x09;
+
+    // a chunk running past the announced payload size is rejected before the last one
+    hex_array[42] -= 1;
+    transaction_parser_init(&parser);
+    buf.size = 60;
+    assert_int_equal(transaction_parser_feed(&parser, &buf, false, &tx), PARSING_OK);
+    buf.size = sizeof(hex_array);
+    assert_int_equal(transaction_parser_feed(&parser, &buf, false, &tx), PARSING_LENGTH_WRONG);
+    hex_array[42] += 1;
+
+    // the whole transaction is needed before the last chunk
+    transaction_parser_init(&parser);
+    buf.size = sizeof(hex_array) - 1;
+    assert_int_equal(transaction_parser_feed(&parser, &buf, true, &tx), PARSING_LENGTH_WRONG);
+
+    // a payload that is not walkable NeoVM code can only be blind signed
+    hex_array[43] = OPCODE_PUSHDATA4;
+    transaction_parser_init(&parser);
+    buf.size = 100;
+    assert_int_equal(transaction_parser_feed(&parser, &buf, false, &tx), PARSING_TX_NOT_DEFINED);
+}
+
+// Serialize `num` transfer states followed by their count, the amount of the state i is i + 1
+// and the last byte of its recipient is i.
+static size_t build_transfer_states(uint8_t *out, uint8_t num) {
+    size_t len = 0;
+
+    for (uint8_t i = 0; i < num; i++) {
+        memcpy(out + len, OPCODE_ST_BEGIN, sizeof(OPCODE_ST_BEGIN));
+        len += sizeof(OPCODE_ST_BEGIN);
+        for (uint8_t j = 0; j < 2; j++) {
+            out[len++] = 0x14;
+            memset(out + len, 0x11 * (j + 1), 20);
+            out[len + 19] = j == 0 ? 0x00 : i;
+            len += 20;
+            memcpy(out + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+            len += sizeof(OPCODE_PARAM_END);
+        }
+        out[len++] = 0x01;
+        out[len++] = i + 1;
+        memcpy(out + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+        len += sizeof(OPCODE_PARAM_END);
+        memcpy(out + len, OPCODE_ST_END, sizeof(OPCODE_ST_END));
+        len += sizeof(OPCODE_ST_END);
+    }
+    out[len++] = 0x01;
+    out[len++] = num;
+    return len;
+}
+
+// Build a native ONT transfer of the transfer states serialized by `build_transfer_states`.
+static size_t build_native_multi_transfer(uint8_t *out, uint8_t num) {
+    const uint8_t header[] = {0x00, 0xd1, 0x15, 0xae, 0x02, 0xab, 0xc4, 0x09, 0x00, 0x00, 0x00,
+                              0x00, 0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                              0x05, 0x81, 0x5d, 0x34, 0xe0, 0xe9, 0xab, 0x73, 0xa1, 0x75, 0xec,
+                              0x86, 0xff, 0xb2, 0x4a, 0xad, 0x5b, 0xee, 0x20, 0xf1};
+    const uint8_t tail[] = {0xc1, 0x08, 't',  'r',  'a',  'n',  's',  'f',  'e',  'r',  0x14,
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x68,
+                            0x16, 'O',  'n',  't',  'o',  'l',  'o',  'g',  'y',  '.',  'N',
+                            'a',  't',  'i',  'v',  'e',  '.',  'I',  'n',  'v',  'o',  'k',
+                            'e'};
+    const size_t payload_offset = sizeof(header) + 3;
+
+    size_t len = build_transfer_states(out + payload_offset, num);
+    memcpy(out + payload_offset + len, tail, sizeof(tail));
+    len += sizeof(tail);
+
+    memcpy(out, header, sizeof(header));
+    out[sizeof(header)] = 0xfd;
+    out[sizeof(header) + 1] = len & 0xff;
+    out[sizeof(header) + 2] = len >> 8;
+    out[payload_offset + len] = 0x00;
+    return payload_offset + len + 1;
+}
+
+static void test_tx_native_multi_transfer_parser(void **state) {
+    (void) state;
+
+    transaction_t tx;
+    tx_parameter_t transfer_state[3];
+    uint64_t amount = 0;
+    tx_param_group_t group;
+    uint8_t hex_array[8192];
+
+    // more transfer states than the parameters array can hold
+    const uint8_t num = PARAMETERS_MAX_NUM / 3 + 10;
+    buffer_t buf = {.ptr = hex_array, .size = build_native_multi_transfer(hex_array, num), .offset = 0};
+
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.method.id, METHOD_ID_TRANSFER);
+    assert_int_equal(tx.method.group.count, num);
+
+    // in order, then backwards to restart from the first state
+    const uint8_t indexes[] = {0, 1, 2, num - 1, 5, 0};
+    for (size_t k = 0; k < sizeof(indexes); k++) {
+        uint8_t i = indexes[k];
+        assert_true(parse_transfer_state_at(&tx, i, transfer_state));
+        assert_int_equal(transfer_state[0].type, PARAM_ADDR);
+        assert_int_equal(hex_array[transfer_state[1].offset + 19], i);
+        assert_true(convert_param_to_uint64_le(hex_array, &transfer_state[2], &amount));
+        assert_int_equal(amount, i + 1);
+    }
+    assert_false(parse_transfer_state_at(&tx, num, transfer_state));
+
+    // the number of transfer states is bounded by the review
+    buf.size = build_transfer_states(hex_array, TRANSFER_STATES_MAX_NUM);
+    buf.offset = 0;
+    assert_true(parse_transfer_state_list(&buf, NULL, &group));
+    assert_int_equal(group.count, TRANSFER_STATES_MAX_NUM);
+    buf.size = build_transfer_states(hex_array, TRANSFER_STATES_MAX_NUM + 1);
+    buf.offset = 0;
+    assert_false(parse_transfer_state_list(&buf, NULL, &group));
+}
+
+static void test_tx_speculative_transfer_states_parser(void **state) {
+    (void) state;
+
+    transaction_t tx;
+    tx_parser_t parser;
+    uint8_t hex_array[2048];
+
+    // 00c66b, two addresses and an amount of 1 byte each followed by 6a7cc8, then 6c
+    const size_t state_len = 3 + 2 * (1 + 20 + 3) + 2 + 3 + 1;
+    const size_t payload_begin = TX_HEADER_LEN + 3;
+
+    // every chunk but the last one holds transfer states
+    const uint8_t num = 20;
+    const size_t len = build_native_multi_transfer(hex_array, num);
+    const size_t states_end = payload_begin + num * state_len;
+
+    memset(&tx, 0, sizeof(tx));
+    transaction_parser_init(&parser);
+    buffer_t buf = {.ptr = hex_array, .size = states_end, .offset = 0};
+    assert_int_equal(transaction_parser_feed(&parser, &buf, false, &tx), PARSING_OK);
+    assert_int_equal(tx.method.transfer_run.count, num);
+    assert_int_equal(tx.method.transfer_run.offset, payload_begin);
+    assert_int_equal(tx.method.transfer_run.end, states_end);
+
+    // the last chunk does not parse the transfer states again, only the count and the tail
+    hex_array[states_end - 1] = 0x00;
+    buf.size = len;
+    assert_int_equal(transaction_parser_feed(&parser, &buf, true, &tx), PARSING_OK);
+    assert_int_equal(tx.method.id, METHOD_ID_TRANSFER);
+    assert_int_equal(tx.method.group.count, num);
+    hex_array[states_end - 1] = OPCODE_ST_END[0];
+
+    // a malformed transfer state ends the run, and is found again once the method is known
+    memset(&tx, 0, sizeof(tx));
+    hex_array[payload_begin + 5 * state_len - 1] = 0x00;
+    assert_int_equal(feed_in_chunks(hex_array, len, 255, &tx), PARSING_BYTECODE_WRONG);
+    assert_int_equal(tx.method.transfer_run.count, 4);
+}
+
+static void test_tx_transfer_state_parser(void **state) {
+    (void) state;
+
+    uint8_t hex_array[128];
+    tx_parameter_t transfer_state[3];
+    size_t cur = 0;
+
+    // usual encoding, matched by the template
+    buffer_t buf = {.ptr = hex_array, .size = build_transfer_states(hex_array, 1) - 2, .offset = 0};
+    assert_true(parse_trasfer_state(&buf, transfer_state, &cur));
+    assert_int_equal(buf.offset, buf.size);
+    assert_int_equal(cur, 3);
+    assert_int_equal(transfer_state[0].offset, 4);
+    assert_int_equal(transfer_state[1].offset, 28);
+    assert_int_equal(transfer_state[1].len, 20);
+    assert_int_equal(transfer_state[2].offset, 51);
+
+    // the to address pushed with PUSHDATA1, decoded instruction by instruction
+    memmove(hex_array + 28, hex_array + 27, buf.size - 27);
+    hex_array[27] = 0x4c;
+    hex_array[28] = 0x14;
+    buf.size++;
+    buf.offset = 0;
+    assert_true(parse_trasfer_state(&buf, transfer_state, &cur));
+    assert_int_equal(buf.offset, buf.size);
+    assert_int_equal(transfer_state[0].offset, 4);
+    assert_int_equal(transfer_state[1].offset, 29);
+    assert_int_equal(transfer_state[1].type, PARAM_ADDR);
+    assert_int_equal(hex_array[transfer_state[1].offset], 0x22);
+
+    // a broken separator after the amount
+    hex_array[buf.size - 2] = 0x7d;
+    buf.offset = 0;
+    assert_false(parse_trasfer_state(&buf, transfer_state, &cur));
+}
+
+static void test_tx_pk_amount_pairs_parser(void **state) {
+    (void) state;
+
+    transaction_t tx;
+    tx_parameter_t pk;
+    tx_parameter_t amount_param;
+    uint64_t amount = 0;
+
+    // unAuthorizeForPeer of two peers
+    uint8_t hex_array[512];
+    const uint8_t header[] = {0x00, 0xd1, 0x69, 0x6d, 0x92, 0x11, 0xc4, 0x09, 0x00, 0x00, 0x00,
+                              0x00, 0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                              0x82, 0x59, 0x95, 0x77, 0x4f, 0xc9, 0xf5, 0x99, 0xe6, 0xf5, 0x27,
+                              0x01, 0x76, 0xb3, 0x74, 0x95, 0xd8, 0x57, 0x98, 0x26};
+    const char method[] = "unAuthorizeForPeer";
+    size_t len = sizeof(header) + 1;
+    memcpy(hex_array, header, sizeof(header));
+
+    memcpy(hex_array + len, OPCODE_ST_BEGIN, sizeof(OPCODE_ST_BEGIN));
+    len += sizeof(OPCODE_ST_BEGIN);
+    hex_array[len++] = 0x14;
+    memcpy(hex_array + len, header + 22, 20);
+    len += 20;
+    memcpy(hex_array + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+    len += sizeof(OPCODE_PARAM_END);
+    hex_array[len++] = 0x52;
+    memcpy(hex_array + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+    len += sizeof(OPCODE_PARAM_END);
+    for (uint8_t i = 0; i < 2; i++) {
+        hex_array[len++] = 0x42;
+        memset(hex_array + len, '0' + i, 66);
+        len += 66;
+        memcpy(hex_array + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+        len += sizeof(OPCODE_PARAM_END);
+    }
+    hex_array[len++] = 0x52;
+    memcpy(hex_array + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+    len += sizeof(OPCODE_PARAM_END);
+    hex_array[len++] = 0x02;
+    hex_array[len++] = 0xe8;
+    hex_array[len++] = 0x03;
+    memcpy(hex_array + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+    len += sizeof(OPCODE_PARAM_END);
+    hex_array[len++] = 0x55;
+    memcpy(hex_array + len, OPCODE_PARAM_END, sizeof(OPCODE_PARAM_END));
+    len += sizeof(OPCODE_PARAM_END);
+    memcpy(hex_array + len, OPCODE_ST_END, sizeof(OPCODE_ST_END));
+    len += sizeof(OPCODE_ST_END);
+    hex_array[len++] = sizeof(method) - 1;
+    memcpy(hex_array + len, method, sizeof(method) - 1);
+    len += sizeof(method) - 1;
+    hex_array[len++] = 0x14;
+    memset(hex_array + len, 0x00, 20);
+    hex_array[len + 19] = 0x07;
+    len += 20;
+    hex_array[len++] = 0x00;
+    hex_array[len++] = 0x68;
+    hex_array[len++] = 0x16;
+    memcpy(hex_array + len, "Ontology.Native.Invoke", 22);
+    len += 22;
+    hex_array[sizeof(header)] = len - sizeof(header) - 1;
+    hex_array[len++] = 0x00;
+
+    buffer_t buf = {.ptr = hex_array, .size = len, .offset = 0};
+
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.method.id, METHOD_ID_UNAUTHORIZE_FOR_PEER);
+    assert_int_equal(tx.method.group.count, 2);
+    assert_int_equal(tx.method.group.total.low, 1005);
+    assert_int_equal(tx.method.group.total.high, 0);
+
+    // the public keys are validated while the payload arrives, whatever the chunks
+    const size_t chunk_lens[] = {1, 70, 255};
+    for (size_t i = 0; i < sizeof(chunk_lens) / sizeof(chunk_lens[0]); i++) {
+        transaction_t tx_chunked;
+        memset(&tx_chunked, 0, sizeof(tx_chunked));
+        assert_int_equal(feed_in_chunks(hex_array, len, chunk_lens[i], &tx_chunked), PARSING_OK);
+        assert_int_equal(tx_chunked.method.pk_run.count, 2);
+        assert_int_equal(tx_chunked.method.pk_run.offset, tx.method.group.offset);
+        assert_int_equal(tx_chunked.method.group.values_offset, tx.method.group.values_offset);
+        assert_int_equal(tx_chunked.method.group.total.low, 1005);
+    }
+
+    const uint8_t indexes[] = {0, 1, 0};
+    const uint64_t amounts[] = {1000, 5};
+    for (size_t k = 0; k < sizeof(indexes); k++) {
+        uint8_t i = indexes[k];
+        assert_true(parse_pk_amount_pair_at(&tx, i, &pk, &amount_param));
+        assert_int_equal(pk.type, PARAM_PUBKEY);
+        assert_int_equal(hex_array[pk.offset], '0' + i);
+        assert_true(convert_param_to_uint64_le(hex_array, &amount_param, &amount));
+        assert_int_equal(amount, amounts[i]);
+    }
+    assert_false(parse_pk_amount_pair_at(&tx, 2, &pk, &amount_param));
+}
+
 int main() {
     const struct CMUnitTest tests[] = {cmocka_unit_test(test_tx_wasm_oep4_transfer_parser),
                                        cmocka_unit_test(test_tx_neo_oep4_transfer_parser),
@@ -455,7 +887,13 @@ int main() {
                                        cmocka_unit_test(test_tx_native_transfer_parser),
                                        cmocka_unit_test(test_tx_note_defined_parser),
                                        cmocka_unit_test(test_tx_error_parser),
-                                       cmocka_unit_test(test_tx_ont_transferv2_parser)};
+                                       cmocka_unit_test(test_tx_ont_transferv2_parser),
+                                       cmocka_unit_test(test_tx_chunked_parser),
+                                       cmocka_unit_test(test_tx_chunked_error_parser),
+                                       cmocka_unit_test(test_tx_native_multi_transfer_parser),
+                                       cmocka_unit_test(test_tx_speculative_transfer_states_parser),
+        cmocka_unit_test(test_tx_transfer_state_parser),
+                                       cmocka_unit_test(test_tx_pk_amount_pairs_parser)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
\ No newline at end of file
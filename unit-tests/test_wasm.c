@@ -0,0 +1,89 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <cmocka.h>
+
+#include "transaction/wasm.h"
+
+static void test_wasm_varuint(void **state) {
+    (void) state;
+
+    uint8_t data[] = {0xfc,
+                      0xfd, 0xfd, 0x00,
+                      0xfe, 0x00, 0x00, 0x01, 0x00,
+                      0xff, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
+    buffer_t buf = {.ptr = data, .size = sizeof(data), .offset = 0};
+    uint64_t value = 0;
+
+    assert_true(wasm_read_varuint(&buf, &value));
+    assert_int_equal(value, 0xfc);
+    assert_true(wasm_read_varuint(&buf, &value));
+    assert_int_equal(value, 0xfd);
+    assert_true(wasm_read_varuint(&buf, &value));
+    assert_int_equal(value, 0x10000);
+    assert_true(wasm_read_varuint(&buf, &value));
+    assert_int_equal(value, 0x100000000);
+    assert_int_equal(buf.offset, sizeof(data));
+
+    // not the shortest encoding
+    uint8_t long_encoding[] = {0xfd, 0xfc, 0x00};
+    buf = (buffer_t){.ptr = long_encoding, .size = sizeof(long_encoding), .offset = 0};
+    assert_false(wasm_read_varuint(&buf, &value));
+
+    // truncated
+    buf = (buffer_t){.ptr = long_encoding, .size = 2, .offset = 0};
+    assert_false(wasm_read_varuint(&buf, &value));
+}
+
+static void test_wasm_bytes(void **state) {
+    (void) state;
+
+    uint8_t data[] = {0x03, 'a', 'b', 'c', 0x05, 'd'};
+    buffer_t buf = {.ptr = data, .size = sizeof(data), .offset = 0};
+    tx_parameter_t param;
+
+    assert_true(wasm_read_bytes(&buf, UINT8_MAX, &param));
+    assert_int_equal(param.offset, 1);
+    assert_int_equal(param.len, 3);
+
+    // longer than the data left, or than allowed
+    assert_false(wasm_read_bytes(&buf, UINT8_MAX, &param));
+    buf.offset = 0;
+    assert_false(wasm_read_bytes(&buf, 2, &param));
+}
+
+static void test_wasm_fixed_size(void **state) {
+    (void) state;
+
+    uint8_t data[20 + 16 + 1 + 1];
+    memset(data, 0, sizeof(data));
+    data[36] = 0x01;
+    data[37] = 0x02;
+    buffer_t buf = {.ptr = data, .size = sizeof(data), .offset = 0};
+    tx_parameter_t param;
+    bool value = false;
+
+    assert_true(wasm_read_address(&buf, &param));
+    assert_int_equal(param.type, PARAM_ADDR);
+    assert_int_equal(param.len, 20);
+    assert_true(wasm_read_u128(&buf, &param));
+    assert_int_equal(param.type, PARAM_UINT128);
+    assert_int_equal(param.offset, 20);
+    assert_true(wasm_read_bool(&buf, &value));
+    assert_true(value);
+    assert_false(wasm_read_bool(&buf, &value));
+    assert_false(wasm_read_address(&buf, &param));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_wasm_varuint),
+                                       cmocka_unit_test(test_wasm_bytes),
+                                       cmocka_unit_test(test_wasm_fixed_size)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}